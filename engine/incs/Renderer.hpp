@@ -4,6 +4,7 @@
 
 constexpr auto FSHADER_PATH = "./engine/shaders/fragment.glsl";
 constexpr auto VSHADER_PATH = "./engine/shaders/vertex.glsl";
+constexpr auto QSHADER_PATH = "./engine/shaders/quad.glsl";	// quad pulling, same fragment shader
 
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
@@ -77,6 +78,7 @@ class Renderer
 {
 	private:
 		GLuint	_shaderprog;
+		GLuint	_quadShaderprog;
 		GLuint	_vao;
 		GLuint	_vbo;
 		GLuint	_ibo;
@@ -85,6 +87,7 @@ class Renderer
 
 		static std::string* loadShaderCode(const char* path);
 		static uint32_t		compileShader(const std::string* code, int32_t type);
+		static GLuint		buildProgram(const char* vertexPath, const char* fragmentPath);
 
 	public:
 		Renderer();
@@ -92,7 +95,7 @@ class Renderer
 		Renderer(const Renderer&) = delete;
 		Renderer& operator=(const Renderer&) = default;
 
-		static void	initProjectionMatrix(const GLFWwindow* window, const std::unique_ptr<Camera>& camera, glm::mat4& mvp);
+		static void	initProjectionMatrix(const GLFWwindow* window, const std::unique_ptr<Camera>& camera, glm::mat4& mvp, float farPlane);
 
 		void	render(const std::vector<Vertex>& vertices, const std::vector<unsigned>& indices, const glm::mat4& mvp) const;
 		void	releaseVBO();
@@ -100,6 +103,7 @@ class Renderer
 		void	setTexArray(const GLuint textureArray) { _textureArray = textureArray; }
 
 		[[nodiscard]] GLuint	getShaderProgram()      const { return _shaderprog;    }
+		[[nodiscard]] GLuint	getQuadShaderProgram()  const { return _quadShaderprog; }
 		[[nodiscard]] GLuint	getVertexArrayObject()  const { return _vao;           }
 		[[nodiscard]] GLuint	getCameraUBO()			const { return _cameraUBO;     }
 		[[nodiscard]] GLuint	getTextureArray()		const { return _textureArray;  }
@@ -12,22 +12,22 @@ layout(std140, binding = 0) uniform WorldUBO
     mat4 MVP;
     vec4 light;
     vec4 cameraPos;
+    vec4 fog;       // x = start, y = end
 };
 
 out vec4 FragColor;
 
 #define WATER_TEXTURE_INDEX 4 // see App.cpp -> loadTextures()
-#define FOG_START 175.0
-#define FOG_END 512.0
 #define FOG_COLOR vec3(0.7, 0.7, 0.7)  // Light grey
 
 float calculateFogFactor(vec3 uWorldPos, vec4 cameraPos)
 {
     float cameraDistXZ = length(uWorldPos.xz - cameraPos.xz);
 
-    // Exponential fog: gets denser faster the farther out you go
-    float fogDensity = 0.015;  // Adjust this to control how fast fog builds up
-    float fogFactor = 1.0 - exp(-fogDensity * (cameraDistXZ - FOG_START));
+    // Exponential fog: gets denser faster the farther out you go, and is
+    // practically opaque by fog.y, the edge of the loaded terrain
+    float fogDensity = 4.0 / max(fog.y - fog.x, 1.0);
+    float fogFactor = 1.0 - exp(-fogDensity * (cameraDistXZ - fog.x));
 
     return clamp(fogFactor, 0.0, 1.0);
 }
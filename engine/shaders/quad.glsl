@@ -0,0 +1,67 @@
+#version 450 core
+
+// ChunkQuad records, see Chunk.hpp; six vertices per quad, no index buffer
+//   x: cell x 5 | y 9 | z 5 | normal 3 | ao 2 per corner
+//   y: w 9 | h 9 | texture layer 8
+layout(std430, binding = 0) readonly buffer Quads
+{
+    uvec2 quads[];
+};
+
+layout(location = 0) uniform vec3 uChunkOrigin;
+
+layout(std140, binding = 0) uniform WorldUBO
+{
+    mat4 MVP;
+    vec4 light;
+    vec4 cameraPos;
+    vec4 fog;
+};
+
+const vec3 normals[6] = vec3[](
+    vec3( 1,  0,  0),  // +X
+    vec3(-1,  0,  0),  // -X
+    vec3( 0,  1,  0),  // +Y
+    vec3( 0, -1,  0),  // -Y
+    vec3( 0,  0,  1),  // +Z
+    vec3( 0,  0, -1)   // -Z
+);
+
+// Two triangles 0-1-2, 0-2-3 over corners k; back faces walk the quad
+// the other way round, as in ChunkQuad::vertex
+const int corners[6] = int[](0, 1, 2, 0, 2, 3);
+const int order[8] = int[](0, 1, 2, 3,  0, 3, 2, 1);
+
+out vec2 vUV;
+out vec3 vNormal;
+out vec3 vWorldPos;
+out float vAO;
+flat out uint vTexIndex;
+
+void main()
+{
+    uvec2 quad = quads[gl_VertexID / 6];
+    int k = corners[gl_VertexID % 6];
+
+    uint normal = (quad.x >> 19) & 7u;
+    int axis = int(normal >> 1);
+    int u = (axis + 1) % 3;
+    int v = (axis + 2) % 3;
+    int corner = order[(normal & 1u) * 4u + uint(k)];
+
+    vec2 size = vec2(quad.y & 511u, (quad.y >> 9) & 511u);
+    vec2 uv = vec2(corner == 1 || corner == 2 ? size.x : 0.0, corner >= 2 ? size.y : 0.0);
+
+    vec3 local = vec3(quad.x & 31u, (quad.x >> 5) & 511u, (quad.x >> 14) & 31u);
+    local[axis] += (normal & 1u) == 0u ? 1.0 : 0.0;
+    local[u] += uv.x;
+    local[v] += uv.y;
+
+    vec3 worldPos = uChunkOrigin + local;
+    gl_Position = MVP * vec4(worldPos, 1.0);
+    vUV = uv;
+    vNormal = normals[normal];
+    vWorldPos = worldPos;
+    vTexIndex = (quad.y >> 18) & 255u;
+    vAO = float((quad.x >> (22 + 2 * k)) & 3u) / 3.0;
+}
@@ -1,16 +1,18 @@
 #version 450 core
 
-layout(location = 0) in vec3  aPos;
-layout(location = 1) in vec2 aUV;
-layout(location = 2) in uint  aTexIndex;
-layout(location = 3) in uint  aNormal;
-layout(location = 4) in uint  aAO;
+// ChunkVertex, see Chunk.hpp
+//   x: x 5 | y 9 | z 5 | normal 3 | ao 2
+//   y: u 9 | v 9 | texture layer 8
+layout(location = 0) in uvec2 aPacked;
+
+layout(location = 0) uniform vec3 uChunkOrigin;
 
 layout(std140, binding = 0) uniform WorldUBO
 {
     mat4 MVP;
     vec4 light;
     vec4 cameraPos;
+    vec4 fog;
 };
 
 const vec3 normals[6] = vec3[](
@@ -30,10 +32,13 @@ flat out uint vTexIndex;
 
 void main()
 {
-    gl_Position = MVP * vec4(aPos, 1.0);
-    vUV = vec2(aUV);
-    vNormal = normals[aNormal];
-    vWorldPos = aPos;
-    vTexIndex = aTexIndex;
-    vAO = float(aAO) / 3.0;
+    vec3 local = vec3(aPacked.x & 31u, (aPacked.x >> 5) & 511u, (aPacked.x >> 14) & 31u);
+    vec3 worldPos = uChunkOrigin + local;
+
+    gl_Position = MVP * vec4(worldPos, 1.0);
+    vUV = vec2(aPacked.y & 511u, (aPacked.y >> 9) & 511u);
+    vNormal = normals[(aPacked.x >> 19) & 7u];
+    vWorldPos = worldPos;
+    vTexIndex = (aPacked.y >> 18) & 255u;
+    vAO = float((aPacked.x >> 22) & 3u) / 3.0;
 }
@@ -12,39 +12,15 @@
 #include <vector>
 #include <cmath>
 
-Renderer::Renderer() : _shaderprog(0), _vao(0), _vbo(0), _ibo(0), _cameraUBO(0), _textureArray(0)
+Renderer::Renderer() : _shaderprog(0), _quadShaderprog(0), _vao(0), _vbo(0), _ibo(0), _cameraUBO(0), _textureArray(0)
 {
-    const std::string* code = loadShaderCode(VSHADER_PATH);
-    const GLuint vshader = compileShader(code, GL_VERTEX_SHADER);
-    delete code;
-    if (!vshader) throw Engine::EngineException(VOX_VERTFAIL);
-
-    code = loadShaderCode(FSHADER_PATH);
-    const GLuint fshader = compileShader(code, GL_FRAGMENT_SHADER);
-    delete code;
-    if (!fshader)
-    {
-        glDeleteShader(vshader);
-        throw Engine::EngineException(VOX_FRAGFAIL);
+    _shaderprog = buildProgram(VSHADER_PATH, FSHADER_PATH);
+    try {
+        _quadShaderprog = buildProgram(QSHADER_PATH, FSHADER_PATH);
     }
-
-    _shaderprog = glCreateProgram();
-    glAttachShader(_shaderprog, vshader);
-    glAttachShader(_shaderprog, fshader);
-    glLinkProgram(_shaderprog);
-
-    glDeleteShader(vshader);
-    glDeleteShader(fshader);
-
-    GLint success;
-    glGetProgramiv(_shaderprog, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        char infolog[512];
-        glGetProgramInfoLog(_shaderprog, sizeof(infolog), nullptr, infolog);
-        std::cerr << "Shader Program Linking Failed: " << infolog << std::endl;
+    catch (...) {
         glDeleteProgram(_shaderprog);
-        throw Engine::EngineException(VOX_SHDRFAIL);
+        throw;
     }
 
     glEnable(GL_DEPTH_TEST);
@@ -88,11 +64,49 @@ Renderer::Renderer() : _shaderprog(0), _vao(0), _vbo(0), _ibo(0), _cameraUBO(0),
 
 Renderer::~Renderer() {
     glDeleteProgram(_shaderprog);
+    glDeleteProgram(_quadShaderprog);
     glDeleteBuffers(1, &_ibo);
     glDeleteBuffers(1, &_vbo);
     glDeleteVertexArrays(1, &_vao);
 }
 
+GLuint Renderer::buildProgram(const char* vertexPath, const char* fragmentPath)
+{
+    const std::string* code = loadShaderCode(vertexPath);
+    const GLuint vshader = compileShader(code, GL_VERTEX_SHADER);
+    delete code;
+    if (!vshader) throw Engine::EngineException(VOX_VERTFAIL);
+
+    code = loadShaderCode(fragmentPath);
+    const GLuint fshader = compileShader(code, GL_FRAGMENT_SHADER);
+    delete code;
+    if (!fshader)
+    {
+        glDeleteShader(vshader);
+        throw Engine::EngineException(VOX_FRAGFAIL);
+    }
+
+    const GLuint program = glCreateProgram();
+    glAttachShader(program, vshader);
+    glAttachShader(program, fshader);
+    glLinkProgram(program);
+
+    glDeleteShader(vshader);
+    glDeleteShader(fshader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        char infolog[512];
+        glGetProgramInfoLog(program, sizeof(infolog), nullptr, infolog);
+        std::cerr << "Shader Program Linking Failed: " << infolog << std::endl;
+        glDeleteProgram(program);
+        throw Engine::EngineException(VOX_SHDRFAIL);
+    }
+    return program;
+}
+
 GLuint Renderer::compileShader(const std::string* code, int32_t type) {
     if (!code) return 0;
 
@@ -153,7 +167,7 @@ void Renderer::render(const std::vector<Vertex>& vertices, const std::vector<uin
     glBindVertexArray(0);
 }
 
-void Renderer::initProjectionMatrix(const GLFWwindow* window, const std::unique_ptr<Camera>& camera, glm::mat4& mvp) {
+void Renderer::initProjectionMatrix(const GLFWwindow* window, const std::unique_ptr<Camera>& camera, glm::mat4& mvp, const float farPlane) {
     int width, height;
     glfwGetFramebufferSize(const_cast<GLFWwindow*>(window), &width, &height);
     const float ratio = static_cast<float>(width) / static_cast<float>(height);
@@ -162,7 +176,7 @@ void Renderer::initProjectionMatrix(const GLFWwindow* window, const std::unique_
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     camera->view = glm::lookAt(camera->pos, camera->pos + camera->dir, camera->up);
-    camera->proj = glm::perspective(glm::radians(camera->fov), ratio, 0.1f, 1024.0f);
+    camera->proj = glm::perspective(glm::radians(camera->fov), ratio, 0.1f, farPlane);
     mvp = camera->proj * camera->view * glm::mat4(1.0f);
 }
 
@@ -4,6 +4,92 @@
 #include "Engine.hpp"
 #include "BlockSystem.hpp"
 #include "World.hpp"
+#include "ViewDistance.hpp"
+
+struct UploadStats {
+	size_t bytesThisFrame = 0;
+	size_t uploadsThisFrame = 0;
+	size_t sectionsThisFrame = 0;	// of Chunk::SECTIONS per upload; fewer after an edit
+	size_t queueDepth = 0;
+};
+
+// A chunk's mesh moved out of it for upload, so GL work runs without chunk_mutex
+struct StagedMesh {
+	std::vector<ChunkQuad> opaque;
+	std::vector<ChunkQuad> transparent;
+	std::array<uint32_t, Chunk::SECTIONS> opaqueSectionQuads{};
+	std::array<uint32_t, Chunk::SECTIONS> transparentSectionQuads{};
+	Chunk::SectionMask sections = 0;
+};
+
+// Scripted straight-line flight at boost speed over fresh terrain, run once
+// without and once with prediction, counting in-frustum chunks inside the
+// view radius that have no mesh yet
+struct FlythroughStats {
+	bool active = false;
+	bool settling = true;
+	int run = 0;					// 0 = prediction off, 1 = on
+	float elapsed = 0.0f;
+	uint64_t holes = 0;
+	float holesPerSecond[2] = {-1.0f, -1.0f};
+	bool restorePrediction = true;
+	glm::vec3 restorePos{};
+};
+
+// Startup KPI, all in seconds since processStart (set by main); negative
+// until reached, or if the disc never filled within STARTUP_POPULATE_TIMEOUT
+struct StartupStats {
+	std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+	float warmUpSeconds = -1.0f;
+	float firstPlayableSeconds = -1.0f;		// first world frame after warm-up
+	float fullyPopulatedSeconds = -1.0f;	// first frame with no visible chunk missing
+};
+
+inline float secondsSince(const std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct QueryBenchmark {
+	float beforeQps = 0.0f;
+	float afterQps = 0.0f;
+	bool mismatch = false;	// the two paths read different voxels
+};
+
+// Block edit to uploaded mesh. Bucket i counts edits under 8 << i ms, the
+// last one everything slower.
+struct EditLatency {
+	static constexpr int BUCKETS = 10;
+	float counts[BUCKETS] = {};		// float for ImGui::PlotHistogram
+	size_t samples = 0;
+	float lastMs = 0.0f;
+	float maxMs = 0.0f;
+
+	void record(float ms);
+};
+
+// Per-frame cull and visible-list build, averaged separately for each mode
+struct CullStats {
+	bool parallel = true;
+	float avgMs[2] = {};	// serial, parallel
+	size_t chunks = 0;
+};
+
+// Chunks per second through each mesher over the same chunk sets: the
+// loaded chunks, then synthetic flat ocean and mountain chunks
+struct MesherBenchmark {
+	enum Set { Loaded, Ocean, Mountain, SET_COUNT };
+	static constexpr const char* SET_NAMES[SET_COUNT] = {"loaded", "ocean", "mountain"};
+
+	float chunksPerSecond[SET_COUNT][2] = {};	// scalar, binary
+	size_t chunks = 0;						// loaded chunks sampled
+	size_t mismatches = 0;					// chunks whose meshes differ
+};
+
+// Tasks per second for 1, 2, 4 and 8 workers, shared queue then stealing
+struct PoolBenchmark {
+	float tasksPerSecond[2][4] = {};
+};
 
 struct HighlightedBlock {
 	glm::vec3 highlightedBlockPos;
@@ -13,6 +99,29 @@ struct HighlightedBlock {
 	bool isHighlighted;
 };
 
+// Everything the debug windows show: snapshots taken once a frame by
+// App::debugStats, and App's own stats read in place
+struct DebugStats {
+	size_t chunkCount;
+	StreamingStats streaming;
+	ThreadPool::Stats tasks;
+	ThreadPool::Telemetry telemetry;
+	ThreadPool::LanePolicy lanePolicy;
+	ScratchArena::Stats scratch;
+	bool prediction;
+	Mesher mesher;
+	bool quadPulling;
+	const UploadStats& uploads;
+	const ViewDistanceController& viewDistance;
+	const FlythroughStats& flythrough;
+	const QueryBenchmark& queries;
+	const StartupStats& startup;
+	const PoolBenchmark& pool;
+	const EditLatency& edits;
+	const CullStats& culling;
+	const MesherBenchmark& meshers;
+};
+
 class App : public Engine
 {
 	public:
@@ -28,6 +137,15 @@ class App : public Engine
 
 		void	toggleFullscreen();
 		void	toggleSpeedBoost();
+		void	togglePrediction();
+		void	toggleLanePolicy();
+		void	toggleParallelCulling();
+		void	toggleMesher();
+		void	toggleQuadPulling();
+		void	benchmarkMeshers();
+		void	startFlythrough();
+		void	benchmarkVoxelQueries();
+		void	benchmarkThreadPool();
 
 		bool	showWireframe;
 		bool	focused;
@@ -38,20 +156,56 @@ class App : public Engine
 		std::unique_ptr<ThreadPool> threadPool;
 
 		HighlightedBlock highlightedBlock;
+		UploadStats uploadStats;
+		ViewDistanceController viewDistance;
+		float cpuFrameSeconds = 0.0f;	// last frame, start to swap
+		FlythroughStats flythrough;
+		QueryBenchmark queryBenchmark;
+		StartupStats startup;
+		PoolBenchmark poolBenchmark;
+		EditLatency editLatency;
+		CullStats cullStats;
+		MesherBenchmark mesherBenchmark;
+		GLuint quadIndexBuffer = 0;	// 0-1-2, 0-2-3 for QUADS_PER_DRAW quads, shared by every batch
+		GLuint emptyVAO = 0;		// quad pulling reads no attributes, but a VAO must be bound
+		bool quadPulling = true;	// how newly uploaded meshes are drawn
+		// Reused every frame by cullChunks
+		std::vector<std::pair<const ChunkCoord, ChunkRecord>*> frameRecords;
+		std::vector<float> frameDistances;
+		std::vector<std::pair<float, ChunkRecord*>> visibleChunks;	// nearest first
+
+		static constexpr double MESH_UPLOAD_BUDGET_MS = 2.0;
+		static constexpr double WARMUP_UPLOAD_BUDGET_MS = 12.0;	// no world frame to protect yet
+		static constexpr int WARMUP_RINGS = 6;
+		static constexpr size_t CULL_GRAIN = 256;	// chunk records per parallel_for slice
+		static constexpr uint32_t QUADS_PER_DRAW = 65536 / 4;	// what 16-bit indices can reach
+		static constexpr uint32_t SECTION_SLACK = 32;			// spare quads per non-empty section slot, plus 1/8
+		static constexpr GLint CHUNK_ORIGIN_UNIFORM = 0;		// layout(location) in vertex.glsl and quad.glsl
+		static constexpr GLuint QUAD_BUFFER_BINDING = 0;		// storage buffer binding in quad.glsl
+		static constexpr float STARTUP_POPULATE_TIMEOUT = 60.0f;	// seconds of looking for a hole-free frame
+		static constexpr float FLYTHROUGH_SECONDS = 15.0f;
+		static constexpr float FLYTHROUGH_SETTLE_TIMEOUT = 30.0f;
+		static constexpr float FLYTHROUGH_RUN_SPACING = 65536.0f;	// blocks between runs
 
 
 	private:
 		void	setCallbackFunctions() const;
 		void	loadTextures();
-		void	renderChunk(const Chunk& chunk, const WorldUBO& worldUbo, GLuint ubo, RenderType type) const;
+		void	renderChunk(const Chunk::ChunkRenderData& mesh, const WorldUBO& worldUbo, GLuint ubo, RenderType type) const;
+		void	drawBatch(const Chunk::RenderBatch& batch, const glm::vec3& origin) const;
+		void	integrateMeshes(double budgetMs);
+		[[nodiscard]] DebugStats	debugStats();
+		void	warmUp();
+		void	updateFlythrough(float dt);
+		[[nodiscard]] size_t	countVisibleHoles();
+		size_t	cullChunks();	// fills visibleChunks, returns the view disc's bytes; caller holds chunk_mutex
 
-		static void	queueVisibleChunksAO(World& world, const std::vector<std::pair<glm::ivec2, Chunk*>>& chunksToCalcAO, ThreadPool& threadPool);
+		void setupQuadIndices();
 		void setupHighlightCube();
 		void cleanupHighlightCube();
 		void updateBlockHighlight();
 		void renderBlockHighlight();
-		static void calcChunkAO(const glm::ivec2& coord, Chunk& chunk, const World& world);
-		static void	uploadChunk(const Chunk& chunk, Chunk::ChunkRenderData& data);
+		size_t	uploadChunk(const ChunkCoord& coord, const StagedMesh& staged, Chunk::ChunkRenderData& data) const;
 };
 
 void error_callback(int error, const char* description);
@@ -62,7 +216,8 @@ void resize_callback(GLFWwindow* window, int width, int height);
 
 void setupImGui(GLFWwindow* window);
 // void renderImGui(const std::unique_ptr<Camera>& camera, bool showWireframe);
-void renderImGui(const std::unique_ptr<Camera>& camera, bool showWireframe, float rgba[4], size_t chunkCount);
+void renderImGui(const std::unique_ptr<Camera>& camera, bool showWireframe, float rgba[4], const DebugStats& debug);
+void renderWarmUpImGui(size_t done, size_t total, float elapsed);
 
 
 
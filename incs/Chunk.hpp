@@ -4,41 +4,165 @@
 #include "defines.hpp"
 #include "Voxel.hpp"
 
-#include <atomic>
+#include <algorithm>
+#include <array>
+#include <bit>
+
+// Chunk-relative vertex, 8 bytes; the shader adds the chunk origin (see
+// vertex.glsl). Every quad is four of these wound 0-1-2, 0-2-3.
+//   position: x 5 | y 9 | z 5 | normal 3 | ao 2
+//   surface:  u 9 | v 9 | texture layer 8
+struct ChunkVertex {
+    uint32_t position;
+    uint32_t surface;
+
+    static constexpr ChunkVertex pack(const int x, const int y, const int z, const int u, const int v,
+        const uint8_t normal, const uint8_t ao, const uint32_t texture)
+    {
+        return {
+            static_cast<uint32_t>(x | y << 5 | z << 14 | normal << 19 | ao << 22),
+            static_cast<uint32_t>(u | v << 9) | texture << 18
+        };
+    }
+
+    [[nodiscard]] glm::ivec3 local() const
+    {
+        return glm::ivec3(static_cast<int>(position & 31), static_cast<int>(position >> 5 & 511),
+            static_cast<int>(position >> 14 & 31));
+    }
+    [[nodiscard]] uint8_t normal() const { return position >> 19 & 7; }
+    [[nodiscard]] uint8_t ao() const { return position >> 22 & 3; }
+    void setAO(const uint8_t ao) { position = (position & ~(3u << 22)) | uint32_t{ao} << 22; }
+};
+static_assert(sizeof(ChunkVertex) == 8);
+
+// One greedy quad, 8 bytes: what the mesher emits and what quad pulling
+// uploads as is (see quad.glsl). Corners k = 0..3 run in ChunkVertex order.
+//   position: cell x 5 | y 9 | z 5 | normal 3 | ao 2 per corner
+//   surface:  w 9 | h 9 | texture layer 8
+struct ChunkQuad {
+    uint32_t position;
+    uint32_t surface;
+
+    static constexpr uint32_t AO_SHIFT = 22;
+    static constexpr uint8_t AO_LIT = 0xFF;     // every corner at 3
+
+    // Face corner (0,0), (w,0), (w,h), (0,h) at each k, front then back faces
+    static constexpr int CORNERS[2][4] = {{0, 1, 2, 3}, {0, 3, 2, 1}};
+
+    static constexpr ChunkQuad pack(const int x, const int y, const int z, const uint8_t normal,
+        const int w, const int h, const uint32_t texture, const uint8_t ao = AO_LIT)
+    {
+        return {
+            static_cast<uint32_t>(x | y << 5 | z << 14 | normal << 19) | uint32_t{ao} << AO_SHIFT,
+            static_cast<uint32_t>(w | h << 9) | texture << 18
+        };
+    }
+
+    [[nodiscard]] int y() const { return static_cast<int>(position >> 5 & 511); }
+    [[nodiscard]] uint8_t normal() const { return position >> 19 & 7; }
+    [[nodiscard]] uint8_t ao(const int k) const { return position >> (AO_SHIFT + 2 * k) & 3; }
+    void setAO(const int k, const uint8_t ao)
+    {
+        const int shift = AO_SHIFT + 2 * k;
+        position = (position & ~(3u << shift)) | uint32_t{ao} << shift;
+    }
+
+    // Corner k as a vertex; back faces run 0-3-2-1 so both windings share
+    // the 0-1-2, 0-2-3 index pattern
+    [[nodiscard]] ChunkVertex vertex(const int k) const
+    {
+        const int n = normal();
+        const int axis = n >> 1;
+        const int u = (axis + 1) % 3;
+        const int v = (axis + 2) % 3;
+        const int w = static_cast<int>(surface & 511);
+        const int h = static_cast<int>(surface >> 9 & 511);
+        const int corner = CORNERS[n & 1][k];
+        const int du = corner == 1 || corner == 2 ? w : 0;
+        const int dv = corner >= 2 ? h : 0;
+
+        int p[3] = {static_cast<int>(position & 31), static_cast<int>(position >> 5 & 511),
+            static_cast<int>(position >> 14 & 31)};
+        p[axis] += (n & 1) ? 0 : 1;
+        p[u] += du;
+        p[v] += dv;
+        return ChunkVertex::pack(p[0], p[1], p[2], du, dv, static_cast<uint8_t>(n), ao(k), surface >> 18);
+    }
+};
+static_assert(sizeof(ChunkQuad) == 8);
 
 // Define a chunk as a 1D vector of voxels
 class Chunk {
 public:
+    // Define the dimensions of a chunk
+    static constexpr uint8_t WIDTH = 16;
+    static constexpr uint16_t HEIGHT = 256;
+    static constexpr uint8_t DEPTH = 16;
+    static constexpr uint32_t SIZE = WIDTH * HEIGHT * DEPTH;
+
+    // Meshes are built, kept and uploaded per 16-block section of the
+    // column, so an edit only redoes the sections around it
+    static constexpr int SECTION_HEIGHT = 16;
+    static constexpr int SECTIONS = HEIGHT / SECTION_HEIGHT;
+    using SectionMask = uint16_t;
+    static constexpr SectionMask ALL_SECTIONS = 0xFFFF;
+    static_assert(SECTIONS == 16);
+
+    // Sections holding any of the layers y0..y1
+    static constexpr SectionMask sectionsOf(const int y0, const int y1)
+    {
+        const int lo = std::clamp(y0, 0, HEIGHT - 1) / SECTION_HEIGHT;
+        const int hi = std::clamp(y1, 0, HEIGHT - 1) / SECTION_HEIGHT;
+        return static_cast<SectionMask>((2u << hi) - (1u << lo));
+    }
+
+    // The contiguous run of sections covering every section in m
+    static constexpr SectionMask sectionSpan(const SectionMask m)
+    {
+        return m ? sectionsOf(std::countr_zero(m) * SECTION_HEIGHT, (std::bit_width(m) - 1) * SECTION_HEIGHT) : 0;
+    }
+
+    // Side faces, each padding the mesh of the chunk beyond it
+    enum Face : uint8_t { NEG_X, POS_X, NEG_Z, POS_Z };
+    static constexpr int FACES = 4;
+
+    // A section's quads in a batch: `quads` drawn from `first`, room for `capacity`
+    struct SectionSlot {
+        uint32_t first = 0;
+        uint32_t quads = 0;
+        uint32_t capacity = 0;
+    };
+
+    // Either ChunkVertex records behind a VAO, drawn with the shared quad
+    // index buffer, or ChunkQuad records pulled from vbo as a storage buffer.
+    // Every section has its own slot with some slack, so an edit rewrites
+    // only its sections
     struct RenderBatch {
         GLuint vao = 0;
         GLuint vbo = 0;
-        GLuint ibo = 0;
-        uint32_t indexCount = 0;
+        uint32_t quadCount = 0;     // drawn, all sections
+        bool pulled = false;
+        size_t bytes = 0;           // buffer size, for the memory estimate
+        std::array<SectionSlot, SECTIONS> sections{};
     };
 
     struct ChunkRenderData {
         RenderBatch opaque;
         RenderBatch transparent;
-    } renderData;
+        glm::vec3 origin{};
+    };
 
     Chunk() = default;
     ~Chunk() = default;
-    Chunk(const Chunk&);
-    Chunk& operator=(const Chunk&);
-
-    void markMeshDirty() { isMeshDirty = true; }
+    Chunk(const Chunk&) = default;
+    Chunk& operator=(const Chunk&) = default;
 
     void setVoxel(const int x, const int y, const int z, const Voxel voxel) {
         if (static_cast<unsigned>(x) >= WIDTH || static_cast<unsigned>(y) >= HEIGHT || static_cast<unsigned>(z) >= DEPTH)
             return;
         voxels[x + y * WIDTH + z * WIDTH * HEIGHT] = voxel;
-        isMeshDirty = true;
-    }
-
-    void setVoxelSilent(const int x, const int y, const int z, const Voxel voxel) {
-        if (static_cast<unsigned>(x) >= WIDTH || static_cast<unsigned>(y) >= HEIGHT || static_cast<unsigned>(z) >= DEPTH)
-            return;
-        voxels[x + y * WIDTH + z * WIDTH * HEIGHT] = voxel;
+        touchEdges(x, z);
     }
 
     [[nodiscard]] Voxel getVoxel(const int x, const int y, const int z) const {
@@ -53,57 +177,37 @@ public:
 
     [[nodiscard]] auto& 		getVoxels() const { return voxels; }
 
-    // Define the dimensions of a chunk
-    static constexpr uint8_t WIDTH = 16;
-    static constexpr uint16_t HEIGHT = 256;
-    static constexpr uint8_t DEPTH = 16;
-    static constexpr uint32_t SIZE = WIDTH * HEIGHT * DEPTH;
+    // Moves on with every write to the face, so a copy of it can tell it is stale
+    [[nodiscard]] uint32_t edgeVersion(const Face face) const { return edgeVersions[face]; }
 
-    std::vector<Vertex>   cachedOpaqueVertices;
-    std::vector<Vertex>   cachedTransparentVertices;
-    std::vector<uint32_t> cachedOpaqueIndices;
-    std::vector<uint32_t> cachedTransparentIndices;
+    // Meshed, not yet uploaded: the quads of meshedSections, section by section
+    std::vector<ChunkQuad> cachedOpaqueQuads;
+    std::vector<ChunkQuad> cachedTransparentQuads;
+    std::array<uint32_t, SECTIONS> opaqueSectionQuads{};
+    std::array<uint32_t, SECTIONS> transparentSectionQuads{};
+    SectionMask meshedSections = 0;
 
-    bool isMeshDirty = false;
-    std::atomic<bool> aoCalculated = false;
+    bool edited = false;          // changed by the player since generation
+    uint32_t meshVersion = 0;     // bumped each time a worker installs a new mesh
     glm::vec3 worldMax{};
     glm::vec3 worldMin{};
 
+    // Streaming bookkeeping for the time-to-visible metric
+    double requestedAt = 0.0;
+    bool requestedInView = false;
+    bool seenVisible = false;
+
 private:
+    void touchEdges(const int x, const int z)
+    {
+        edgeVersions[NEG_X] += x == 0;
+        edgeVersions[POS_X] += x == WIDTH - 1;
+        edgeVersions[NEG_Z] += z == 0;
+        edgeVersions[POS_Z] += z == DEPTH - 1;
+    }
+
     std::array<Voxel, SIZE> voxels{};
+    std::array<uint32_t, FACES> edgeVersions{};
 };
 
-inline Chunk::Chunk(const Chunk& other)
-    : renderData(other.renderData),
-      cachedOpaqueVertices(other.cachedOpaqueVertices),
-      cachedTransparentVertices(other.cachedTransparentVertices),
-      cachedOpaqueIndices(other.cachedOpaqueIndices),
-      cachedTransparentIndices(other.cachedTransparentIndices),
-      isMeshDirty(other.isMeshDirty),
-      aoCalculated(other.aoCalculated.load()),
-      worldMax(other.worldMax),
-      worldMin(other.worldMin),
-      voxels(other.voxels)
-{
-}
-
-inline Chunk& Chunk::operator=(const Chunk& other)
-{
-    if (this == &other)
-        return *this;
-
-    renderData = other.renderData;
-    cachedOpaqueVertices = other.cachedOpaqueVertices;
-    cachedTransparentVertices = other.cachedTransparentVertices;
-    cachedOpaqueIndices = other.cachedOpaqueIndices;
-    cachedTransparentIndices = other.cachedTransparentIndices;
-    isMeshDirty = other.isMeshDirty;
-    aoCalculated.store(other.aoCalculated.load());
-    worldMax = other.worldMax;
-    worldMin = other.worldMin;
-    voxels = other.voxels;
-
-    return *this;
-}
-
 #endif // CHUNK_HPP
@@ -0,0 +1,80 @@
+#ifndef CHUNK_NEIGHBORHOOD_HPP
+#define CHUNK_NEIGHBORHOOD_HPP
+
+#include "World.hpp"
+
+#include <span>
+
+// Pins the 3x3 block of chunks around a center chunk so voxel queries inside
+// it are array math instead of a floorDiv and a map lookup each. Holds raw
+// pointers into the chunk table: only valid while World::chunk_mutex is held.
+// Unloaded chunks and anything outside the block read as air.
+class ChunkNeighborhood {
+public:
+	static constexpr int W = Chunk::WIDTH;
+	static constexpr int H = Chunk::HEIGHT;
+	static constexpr int D = Chunk::DEPTH;
+
+	ChunkNeighborhood(const World& world, const ChunkCoord& center)
+		: originX(center.x * W), originZ(center.y * D)
+	{
+		for (int dz = -1; dz <= 1; ++dz)
+			for (int dx = -1; dx <= 1; ++dx)
+				chunks[(dz + 1) * 3 + (dx + 1)] = world.findChunk(center + ChunkCoord(dx, dz));
+	}
+
+	// Neighborhood around the chunk containing a world position
+	ChunkNeighborhood(const World& world, const glm::ivec3& worldPos)
+		: ChunkNeighborhood(world, ChunkCoord(floorDiv(worldPos.x, W), floorDiv(worldPos.z, D)))
+	{
+	}
+
+	// Coordinates relative to the center chunk's origin, x in [-W, 2W)
+	[[nodiscard]] Voxel localVoxel(const int lx, const int y, const int lz) const
+	{
+		const auto sx = static_cast<unsigned>(lx + W);
+		const auto sz = static_cast<unsigned>(lz + D);
+		if (sx >= 3 * W || sz >= 3 * D || static_cast<unsigned>(y) >= H)
+			return 0;
+
+		const Chunk* chunk = chunks[(sz / D) * 3 + sx / W];
+		return chunk ? chunk->getVoxels()[sx % W + y * W + (sz % D) * W * H] : 0;
+	}
+
+	[[nodiscard]] Voxel voxelAt(const int wx, const int wy, const int wz) const
+	{
+		return localVoxel(wx - originX, wy, wz - originZ);
+	}
+
+	[[nodiscard]] Voxel voxelAt(const glm::ivec3& worldPos) const
+	{
+		return voxelAt(worldPos.x, worldPos.y, worldPos.z);
+	}
+
+	[[nodiscard]] bool isSolid(const int wx, const int wy, const int wz) const
+	{
+		return isActive(voxelAt(wx, wy, wz));
+	}
+
+	// The X run of one chunk at (wy, wz), starting at the chunk's first column;
+	// empty if that chunk is not loaded
+	[[nodiscard]] std::span<const Voxel> row(const int wx, const int wy, const int wz) const
+	{
+		const auto sx = static_cast<unsigned>(wx - originX + W);
+		const auto sz = static_cast<unsigned>(wz - originZ + D);
+		if (sx >= 3 * W || sz >= 3 * D || static_cast<unsigned>(wy) >= H)
+			return {};
+
+		const Chunk* chunk = chunks[(sz / D) * 3 + sx / W];
+		if (!chunk)
+			return {};
+		return std::span(chunk->getVoxels()).subspan(wy * W + (sz % D) * W * H, W);
+	}
+
+private:
+	const Chunk* chunks[9] = {};
+	int originX;
+	int originZ;
+};
+
+#endif // CHUNK_NEIGHBORHOOD_HPP
@@ -0,0 +1,64 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Unbounded lock-free multi-producer / single-consumer queue (Vyukov).
+// Any thread may push; only one thread at a time may pop.
+template<typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() : head(new Node), tail(head.load(std::memory_order_relaxed)), count(0) {}
+
+    ~MPSCQueue()
+    {
+        while (tail) {
+            Node* next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    void push(T value)
+    {
+        Node* node = new Node;
+        node->value = std::move(value);
+
+        Node* prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool pop(T& out)
+    {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next)
+            return false;
+
+        out = std::move(next->value);
+        delete tail;
+        tail = next;
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate while producers are active
+    [[nodiscard]] size_t size() const { return count.load(std::memory_order_relaxed); }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    std::atomic<Node*> head;    // producers
+    Node* tail;                 // consumer, always a drained stub
+    std::atomic<size_t> count;
+};
+
+#endif // MPSC_QUEUE_HPP
@@ -0,0 +1,221 @@
+#ifndef SCRATCH_ARENA_HPP
+#define SCRATCH_ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Per-thread bump allocator for job scratch: noise layers, neighbour copies,
+// mesher masks and quads. Everything allocated inside a Scope is released
+// when it closes, so the same block serves job after job. A job that outgrows
+// the block takes the rest from the heap; the block is regrown to the job's
+// high-water mark once the outermost scope closes, so it happens once.
+// Only trivially copyable types: nothing is ever constructed or destroyed.
+class ScratchArena {
+public:
+    static constexpr size_t INITIAL_CAPACITY = 4 << 20;
+    static constexpr size_t GROWTH_STEP = 1 << 20;
+
+    struct Stats {
+        size_t arenas = 0;          // threads that have allocated scratch
+        size_t reservedBytes = 0;   // blocks of all arenas
+        size_t peakBytes = 0;       // largest single job
+        uint64_t jobs = 0;          // outermost scopes closed
+        uint64_t overflows = 0;     // allocations that missed the block
+    };
+
+    // Rewinds the arena to where it was when the scope opened
+    class Scope {
+    public:
+        explicit Scope(ScratchArena& arena = local()) : arena(arena), mark(arena.offset) { ++arena.depth; }
+
+        ~Scope()
+        {
+            arena.offset = mark;
+            if (--arena.depth == 0)
+                arena.endJob();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ScratchArena& arena;
+        size_t mark;
+    };
+
+    static ScratchArena& local()
+    {
+        thread_local ScratchArena arena;
+        return arena;
+    }
+
+    // n uninitialised objects, valid until the enclosing scope closes
+    template<typename T>
+    [[nodiscard]] T* allocate(const size_t n = 1)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        return static_cast<T*>(allocateBytes(n * sizeof(T), alignof(T)));
+    }
+
+    template<typename T>
+    [[nodiscard]] T* allocateZeroed(const size_t n = 1)
+    {
+        T* p = allocate<T>(n);
+        std::memset(static_cast<void*>(p), 0, n * sizeof(T));
+        return p;
+    }
+
+    // Scopes open on this arena; memory from a deeper one is gone once it closes
+    [[nodiscard]] int scopeDepth() const { return depth; }
+
+    [[nodiscard]] static Stats stats()
+    {
+        Stats s;
+        s.arenas = totalArenas.load(std::memory_order_relaxed);
+        s.reservedBytes = totalReserved.load(std::memory_order_relaxed);
+        s.peakBytes = peakJob.load(std::memory_order_relaxed);
+        s.jobs = totalJobs.load(std::memory_order_relaxed);
+        s.overflows = totalOverflows.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    ~ScratchArena()
+    {
+        if (!block)
+            return;
+        totalArenas.fetch_sub(1, std::memory_order_relaxed);
+        totalReserved.fetch_sub(capacity, std::memory_order_relaxed);
+    }
+
+private:
+    ScratchArena() = default;
+
+    void* allocateBytes(const size_t bytes, const size_t align)
+    {
+        if (!block)
+            reserve(INITIAL_CAPACITY);
+
+        const size_t start = (offset + align - 1) & ~(align - 1);
+        if (start + bytes <= capacity) {
+            offset = start + bytes;
+            highWater = std::max(highWater, offset + overflowBytes);
+            return block.get() + start;
+        }
+
+        overflow.push_back(std::make_unique_for_overwrite<std::byte[]>(bytes));
+        overflowBytes += bytes;
+        highWater = std::max(highWater, offset + overflowBytes);
+        totalOverflows.fetch_add(1, std::memory_order_relaxed);
+        return overflow.back().get();
+    }
+
+    void reserve(const size_t bytes)
+    {
+        if (block)
+            totalReserved.fetch_sub(capacity, std::memory_order_relaxed);
+        else
+            totalArenas.fetch_add(1, std::memory_order_relaxed);
+
+        block = std::make_unique_for_overwrite<std::byte[]>(bytes);
+        capacity = bytes;
+        totalReserved.fetch_add(capacity, std::memory_order_relaxed);
+    }
+
+    void endJob()
+    {
+        totalJobs.fetch_add(1, std::memory_order_relaxed);
+        size_t peak = peakJob.load(std::memory_order_relaxed);
+        while (highWater > peak && !peakJob.compare_exchange_weak(peak, highWater, std::memory_order_relaxed))
+            ;
+
+        if (!overflow.empty()) {
+            overflow.clear();
+            overflowBytes = 0;
+            reserve((highWater + GROWTH_STEP - 1) / GROWTH_STEP * GROWTH_STEP);
+        }
+        highWater = 0;
+    }
+
+    // Across all arenas, for stats()
+    static inline std::atomic<size_t> totalArenas{0};
+    static inline std::atomic<size_t> totalReserved{0};
+    static inline std::atomic<size_t> peakJob{0};
+    static inline std::atomic<uint64_t> totalJobs{0};
+    static inline std::atomic<uint64_t> totalOverflows{0};
+
+    std::unique_ptr<std::byte[]> block;
+    size_t capacity = 0;
+    size_t offset = 0;
+    size_t highWater = 0;       // this job, overflow included
+    int depth = 0;
+    std::vector<std::unique_ptr<std::byte[]>> overflow;
+    size_t overflowBytes = 0;
+};
+
+// Growable array in a ScratchArena. Growing bumps a new buffer and leaves
+// the old one behind until the scope closes, so copy the contents out
+// (exactly sized) before that. It may only grow in the scope it was made
+// in: a buffer from a nested scope would be rewound under it
+template<typename T>
+class ScratchVector {
+public:
+    explicit ScratchVector(const size_t capacity, ScratchArena& arena = ScratchArena::local())
+        : arena(arena), items(arena.allocate<T>(capacity)), cap(capacity), depth(arena.scopeDepth())
+    {
+    }
+
+    void push_back(const T& value)
+    {
+        if (count == cap)
+            reserve(cap ? cap * 2 : 16);
+        items[count++] = value;
+    }
+
+    void reserve(const size_t n)
+    {
+        if (n <= cap)
+            return;
+        assert(arena.scopeDepth() == depth && "ScratchVector grown inside a nested scope");
+        T* grown = arena.allocate<T>(n);
+        if (count)
+            std::memcpy(static_cast<void*>(grown), items, count * sizeof(T));
+        items = grown;
+        cap = n;
+    }
+
+    // Trivial types: growing leaves the new elements uninitialised
+    void resize(const size_t n)
+    {
+        reserve(n);
+        count = n;
+    }
+
+    void clear() { count = 0; }
+
+    [[nodiscard]] T* data() const { return items; }
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] T* begin() const { return items; }
+    [[nodiscard]] T* end() const { return items + count; }
+    T& operator[](const size_t i) const { return items[i]; }
+
+private:
+    ScratchArena& arena;
+    T* items;
+    size_t cap;
+    size_t count = 0;
+    int depth;      // scopes open when it was made
+};
+
+#endif // SCRATCH_ARENA_HPP
@@ -4,9 +4,6 @@
 #include "Chunk.hpp"
 #include "glm/glm.hpp"
 
-#include <vector>
-#include <unordered_map>
-
 #include "World.hpp"
 
 using ChunkCoord = glm::ivec2;
@@ -23,17 +20,6 @@ typedef enum class BlockType {
 	Amethyst,
 } BlockType;
 
-struct NoiseCache {
-	std::vector<float> terrain;
-	std::vector<float> temperature;
-	std::vector<float> humidity;
-	std::vector<float> mountain;
-};
-
-inline uint64_t hashCoord(const ChunkCoord coord) {
-	return (static_cast<uint64_t>(coord.x) << 32) | static_cast<uint32_t>(coord.y);
-}
-
 class TerrainGenerator {
 public:
 	TerrainGenerator(int seed = 1337);
@@ -63,9 +49,6 @@ private:
 	// Biome determination
 	static BlockType determineBiome(float temperature, float humidity, float continentalNoise);
 
-	std::unordered_map<uint64_t, NoiseCache> noiseCache;
-	std::mutex noiseCacheMutex;
-
 	static inline int seed = 1337;
 
 	// Terrain parameters
@@ -3,65 +3,243 @@
 
 #include <vector>
 #include <thread>
-#include <queue>
 #include <functional>
 #include <condition_variable>
 #include <mutex>
 #include <future>
 #include <atomic>
+#include <array>
+#include <memory>
+#include <cstdint>
 #include <type_traits>
 #include <stdexcept>
+#include <cstddef>
+#include <new>
+#include <algorithm>
+#include <exception>
+#include <chrono>
 
-class ThreadPool {
+// Chase-Lev deque. The owning worker pushes and pops at the bottom (LIFO,
+// cache-warm); any other thread steals from the top (FIFO). Fixed capacity:
+// push fails when full and the caller falls back to the shared queue.
+template<typename T>
+class WorkStealingDeque {
 public:
-    explicit ThreadPool(const size_t threadCount = 8): stop(false), active_tasks(0)
+    static constexpr int64_t CAPACITY = 4096;
+
+    bool push(T item)
     {
-        workers.reserve(threadCount);
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= CAPACITY)
+            return false;
+
+        buffer[b & MASK].store(item, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    T pop()
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        T item{};
+        if (t <= b) {
+            item = buffer[b & MASK].load(std::memory_order_relaxed);
+            if (t == b) {
+                // Last item: race thieves for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = T{};
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+            bottom.store(b + 1, std::memory_order_relaxed);
+        return item;
+    }
 
-        for (size_t i = 0; i < threadCount; ++i) {
-            workers.emplace_back([this] {
-                for (;;) {
-                    std::function<void()> task;
+    T steal()
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return T{};
+
+        T item = buffer[t & MASK].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return T{};
+        return item;
+    }
+
+private:
+    static constexpr int64_t MASK = CAPACITY - 1;
 
-                    {
-                        std::unique_lock<std::mutex> lock(queue_mutex);
-                        condition.wait(lock, [this] {
-                            return stop || !tasks.empty();
-                        });
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::array<std::atomic<T>, CAPACITY> buffer{};
+};
 
-                        if (stop && tasks.empty())
-                            return;
+// One queued task: the callable lives inline when it fits, so submitting
+// it costs no allocation once the slot pool has grown to the working set.
+// `next` links the slot into the free list or the injection queue.
+struct TaskSlot {
+    static constexpr size_t INLINE_SIZE = 48;
 
-                        task = std::move(tasks.front());
-                        tasks.pop();
-                        ++active_tasks;
-                    }
+    alignas(16) std::byte storage[INLINE_SIZE];
+    void (*run)(TaskSlot&) = nullptr;   // invokes, then destroys the callable
+    TaskSlot* next = nullptr;
+    int64_t queuedAt = 0;               // steady clock ns, for the wait histogram
+    uint8_t tag = 0;
 
-                    try {
-                        task();
-                    } catch (...) {
-                    }
+    template<typename F>
+    static constexpr bool fitsInline = sizeof(F) <= INLINE_SIZE && alignof(F) <= 16
+        && std::is_nothrow_move_constructible_v<F>;
 
-                    --active_tasks;
-                    condition.notify_all();
+    // Returns false if the callable had to go on the heap
+    template<typename F>
+    bool emplace(F&& f)
+    {
+        using Fn = std::decay_t<F>;
+
+        if constexpr (fitsInline<Fn>) {
+            new (storage) Fn(std::forward<F>(f));
+            run = [](TaskSlot& slot) {
+                Fn* fn = std::launder(reinterpret_cast<Fn*>(slot.storage));
+                try {
+                    (*fn)();
+                } catch (...) {
                 }
-            });
+                fn->~Fn();
+            };
+            return true;
+        }
+        else {
+            new (storage) Fn*(new Fn(std::forward<F>(f)));
+            run = [](TaskSlot& slot) {
+                Fn* fn = *std::launder(reinterpret_cast<Fn**>(slot.storage));
+                try {
+                    (*fn)();
+                } catch (...) {
+                }
+                delete fn;
+            };
+            return false;
+        }
+    }
+};
+
+class ThreadPool {
+public:
+    enum class Mode {
+        SharedQueue,    // every task goes through the one locked queue
+        WorkStealing    // tasks spawned by a worker stay on its own deque
+    };
+
+    // Latency classes, most urgent first
+    enum class Lane : uint8_t {
+        Interactive,    // the player is waiting on it, e.g. remeshing an edit
+        Streaming,      // world loading and meshing
+        Background      // nice to have
+    };
+    static constexpr size_t LANE_COUNT = 3;
+
+    enum class LanePolicy : uint8_t {
+        Strict,     // always the most urgent non-empty lane
+        Weighted    // lanes take turns by LANE_WEIGHTS so none starves
+    };
+    static constexpr uint32_t LANE_WEIGHTS[LANE_COUNT] = {8, 4, 1};
+
+    // What a task is for, so telemetry can tell the job kinds apart
+    enum class Tag : uint8_t {
+        Other,
+        Generate,
+        Mesh
+    };
+    static constexpr size_t TAG_COUNT = 3;
+    static constexpr const char* TAG_NAMES[TAG_COUNT] = {"other", "generate", "mesh"};
+
+    // Enqueue-to-start wait: bucket i counts waits under 8 << i us, the last
+    // one everything slower
+    static constexpr size_t WAIT_BUCKETS = 16;
+    using WaitHistogram = std::array<uint64_t, WAIT_BUCKETS>;
+
+    struct WorkerTelemetry {
+        uint64_t tasks = 0;
+        uint64_t steals = 0;
+        double busyMs = 0.0;
+        double idleMs = 0.0;
+    };
+
+    // Point-in-time copy of the counters; each one is read relaxed, so the
+    // set is only roughly consistent while tasks run
+    struct Telemetry {
+        std::vector<WorkerTelemetry> workers;
+        std::array<WaitHistogram, TAG_COUNT> wait{};
+        std::array<size_t, LANE_COUNT> laneDepth{};
+        size_t queued = 0;
+
+        // Upper edge of the bucket holding the p-th quantile, in us
+        [[nodiscard]] static float waitPercentileUs(const WaitHistogram& histogram, const double p)
+        {
+            uint64_t total = 0;
+            for (const uint64_t n : histogram)
+                total += n;
+            if (total == 0)
+                return 0.0f;
+
+            uint64_t seen = 0;
+            for (size_t b = 0; b < WAIT_BUCKETS; ++b) {
+                seen += histogram[b];
+                if (static_cast<double>(seen) >= p * static_cast<double>(total))
+                    return static_cast<float>(8u << b);
+            }
+            return static_cast<float>(8u << (WAIT_BUCKETS - 1));
+        }
+    };
+
+    // Running totals; heap allocations stay flat once the slot pool is warm
+    struct Stats {
+        size_t submitted = 0;       // tasks through submit/submitBatch
+        size_t enqueued = 0;        // tasks through enqueue (future + shared state each)
+        size_t slots = 0;           // task slots ever created
+        size_t heapCallables = 0;   // submitted callables too big for a slot
+
+        [[nodiscard]] size_t heapAllocations() const
+        {
+            return slots / SLOT_BLOCK + heapCallables + enqueued;
         }
+    };
+
+    static constexpr size_t SLOT_BLOCK = 256;   // slots allocated at a time
+
+    explicit ThreadPool(const size_t threadCount = 8, const Mode mode = Mode::WorkStealing)
+        : mode(mode), locals(threadCount)
+    {
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+            workers.emplace_back([this, i] { workerLoop(i); });
     }
 
     ~ThreadPool()
     {
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+            std::lock_guard<std::mutex> lock(sleep_mutex);
             stop = true;
         }
-
-        condition.notify_all();
+        sleep_cv.notify_all();
 
         for (std::thread& worker : workers)
             worker.join();
     }
 
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
     // Enqueue a task and get a future
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args)
@@ -74,38 +252,481 @@ public:
         );
 
         std::future<return_type> res = task->get_future();
+        counters.enqueued.fetch_add(1, std::memory_order_relaxed);
+        ensureRunning();
+        TaskSlot* slot = acquireSlots(1);
+        slot->emplace([task]() { (*task)(); });
+        slot->tag = static_cast<uint8_t>(Tag::Other);
+        push(slot, slot, 1, Lane::Streaming);
+        return res;
+    }
 
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+    // Fire and forget: no future, and no allocation when the callable fits
+    // in a slot. Exceptions are swallowed like enqueue's unread ones.
+    template<class F>
+    void submit(F&& f, const Lane lane = Lane::Streaming, const Tag tag = Tag::Other)
+    {
+        ensureRunning();
+        TaskSlot* slot = acquireSlots(1);
+        fill(slot, std::forward<F>(f));
+        slot->tag = static_cast<uint8_t>(tag);
+        counters.submitted.fetch_add(1, std::memory_order_relaxed);
+        push(slot, slot, 1, lane);
+    }
 
-            if (stop)
-                throw std::runtime_error("enqueue on stopped ThreadPool");
+    // Submits make(0) .. make(count - 1) with one trip through the slot
+    // pool and the queue lock, and one wake-up
+    template<class Make>
+    void submitBatch(const size_t count, Make&& make, const Lane lane = Lane::Streaming, const Tag tag = Tag::Other)
+    {
+        if (count == 0)
+            return;
 
-            tasks.emplace([task]() { (*task)(); });
+        ensureRunning();
+        TaskSlot* first = acquireSlots(count);
+        TaskSlot* last = first;
+        for (size_t i = 0;; ++i) {
+            fill(last, make(i));
+            last->tag = static_cast<uint8_t>(tag);
+            if (i + 1 == count)
+                break;
+            last = last->next;
         }
+        counters.submitted.fetch_add(count, std::memory_order_relaxed);
+        push(first, last, count, lane);
+    }
 
-        condition.notify_one();
-        return res;
+    // Runs body(lo, hi) over [begin, end) in chunks of `grain`, on the
+    // calling thread and up to one helper per worker; returns once every
+    // chunk is done. Helpers go in the interactive lane since the caller is
+    // blocked on them. The first exception thrown by body is rethrown here.
+    template<class Body>
+    void parallel_for(const size_t begin, const size_t end, const size_t grain, Body&& body)
+    {
+        if (begin >= end)
+            return;
+
+        const size_t step = std::max<size_t>(grain, 1);
+        const size_t chunks = (end - begin + step - 1) / step;
+        if (chunks == 1 || workers.empty()) {
+            body(begin, end);
+            return;
+        }
+
+        // Shared so a helper that only starts after the loop is over can
+        // still find out there is nothing left, without touching `body`
+        auto loop = std::make_shared<ForLoop>();
+        loop->begin = begin;
+        loop->end = end;
+        loop->step = step;
+        loop->chunks = chunks;
+
+        submitBatch(std::min(workers.size(), chunks - 1), [&loop, &body](size_t) {
+            return [loop, &body] { runChunks(*loop, body); };
+        }, Lane::Interactive);
+
+        runChunks(*loop, body);
+        while (loop->done.load(std::memory_order_acquire) < chunks)
+            std::this_thread::yield();
+
+        if (loop->error)
+            std::rethrow_exception(loop->error);
+    }
+
+    // map(lo, hi) -> T per chunk, folded with combine in index order
+    template<class T, class Map, class Combine>
+    T parallel_reduce(const size_t begin, const size_t end, const size_t grain, T identity, Map&& map, Combine&& combine)
+    {
+        if (begin >= end)
+            return identity;
+
+        const size_t step = std::max<size_t>(grain, 1);
+        std::vector<T> partial((end - begin + step - 1) / step, identity);
+
+        parallel_for(0, partial.size(), 1, [&](const size_t lo, const size_t hi) {
+            for (size_t c = lo; c < hi; ++c)
+                partial[c] = map(begin + c * step, std::min(end, begin + (c + 1) * step));
+        });
+
+        for (T& value : partial)
+            identity = combine(std::move(identity), std::move(value));
+        return identity;
+    }
+
+    // Tasks queued but not yet picked up by a worker
+    size_t pendingTasks() const
+    {
+        return queued.load(std::memory_order_relaxed);
     }
 
     // Wait until all tasks are completed
     void wait()
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        condition.wait(lock, [this] {
-            return tasks.empty() && active_tasks == 0;
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done_cv.wait(lock, [this] {
+            return unfinished.load() == 0;
         });
     }
 
+    [[nodiscard]] size_t size() const { return workers.size(); }
+    [[nodiscard]] Mode getMode() const { return mode; }
+
+    void setLanePolicy(const LanePolicy policy) { lanePolicy.store(policy, std::memory_order_relaxed); }
+    [[nodiscard]] LanePolicy getLanePolicy() const { return lanePolicy.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] Telemetry telemetry() const
+    {
+        Telemetry out;
+        out.workers.reserve(locals.size());
+        for (const Local& local : locals) {
+            out.workers.push_back({
+                local.tasks.load(std::memory_order_relaxed),
+                local.steals.load(std::memory_order_relaxed),
+                static_cast<double>(local.busyNs.load(std::memory_order_relaxed)) / 1e6,
+                static_cast<double>(local.idleNs.load(std::memory_order_relaxed)) / 1e6
+            });
+            for (size_t t = 0; t < TAG_COUNT; ++t)
+                for (size_t b = 0; b < WAIT_BUCKETS; ++b)
+                    out.wait[t][b] += local.wait[t][b].load(std::memory_order_relaxed);
+        }
+        for (size_t lane = 0; lane < LANE_COUNT; ++lane)
+            out.laneDepth[lane] = lanes[lane].depth.load(std::memory_order_relaxed);
+        out.queued = queued.load(std::memory_order_relaxed);
+        return out;
+    }
+
+    [[nodiscard]] Stats stats() const
+    {
+        return {
+            counters.submitted.load(std::memory_order_relaxed),
+            counters.enqueued.load(std::memory_order_relaxed),
+            counters.slots.load(std::memory_order_relaxed),
+            counters.heapCallables.load(std::memory_order_relaxed)
+        };
+    }
+
 private:
+    static constexpr size_t LOCAL_FREE_MAX = 64;    // slots a worker keeps before returning them
+
+    struct alignas(64) Local {
+        WorkStealingDeque<TaskSlot*> deque;
+        TaskSlot* freeSlots = nullptr;      // owner only
+        size_t freeCount = 0;
+        uint32_t turn = 0;                  // weighted lane rotation, owner only
+
+        // Telemetry: written by the owner only, read by telemetry()
+        std::atomic<uint64_t> tasks{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<int64_t> busyNs{0};
+        std::atomic<int64_t> idleNs{0};
+        std::array<std::array<std::atomic<uint64_t>, WAIT_BUCKETS>, TAG_COUNT> wait{};
+    };
+
+    static int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Single writer, so a relaxed load and store is enough
+    template<typename T>
+    static void bump(std::atomic<T>& counter, const T by)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    struct LaneQueue {
+        TaskSlot* head = nullptr;
+        TaskSlot* tail = nullptr;
+        std::atomic<size_t> depth{0};       // read without the lock to skip empty lanes
+    };
+
+    struct ForLoop {
+        size_t begin = 0;
+        size_t end = 0;
+        size_t step = 1;
+        size_t chunks = 0;
+        std::atomic<size_t> next{0};    // next chunk to claim
+        std::atomic<size_t> done{0};    // chunks finished
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;       // written once, read after done == chunks
+    };
+
+    template<class Body>
+    static void runChunks(ForLoop& loop, Body& body)
+    {
+        for (size_t c; (c = loop.next.fetch_add(1, std::memory_order_relaxed)) < loop.chunks;) {
+            const size_t lo = loop.begin + c * loop.step;
+            try {
+                body(lo, std::min(loop.end, lo + loop.step));
+            } catch (...) {
+                if (!loop.failed.exchange(true))
+                    loop.error = std::current_exception();
+            }
+            loop.done.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    // Index of the calling worker in `pool`, if it is one
+    static inline thread_local const ThreadPool* currentPool = nullptr;
+    static inline thread_local size_t currentIndex = 0;
+
+    template<class F>
+    void fill(TaskSlot* slot, F&& f)
+    {
+        if (!slot->emplace(std::forward<F>(f)))
+            counters.heapCallables.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // A chain of `count` free slots linked through `next`
+    TaskSlot* acquireSlots(const size_t count)
+    {
+        TaskSlot* chain = nullptr;
+        size_t have = 0;
+
+        if (currentPool == this) {
+            Local& local = locals[currentIndex];
+            while (have < count && local.freeSlots) {
+                TaskSlot* slot = local.freeSlots;
+                local.freeSlots = slot->next;
+                --local.freeCount;
+                slot->next = chain;
+                chain = slot;
+                ++have;
+            }
+        }
+        if (have == count)
+            return chain;
+
+        std::lock_guard<std::mutex> lock(slot_mutex);
+        while (have < count) {
+            if (!freeSlots) {
+                auto& block = slotBlocks.emplace_back(std::make_unique<TaskSlot[]>(SLOT_BLOCK));
+                for (size_t i = 0; i < SLOT_BLOCK; ++i) {
+                    block[i].next = freeSlots;
+                    freeSlots = &block[i];
+                }
+                counters.slots.fetch_add(SLOT_BLOCK, std::memory_order_relaxed);
+            }
+            TaskSlot* slot = freeSlots;
+            freeSlots = slot->next;
+            slot->next = chain;
+            chain = slot;
+            ++have;
+        }
+        return chain;
+    }
+
+    void releaseSlot(const size_t index, TaskSlot* slot)
+    {
+        Local& local = locals[index];
+        slot->run = nullptr;
+        slot->next = local.freeSlots;
+        local.freeSlots = slot;
+        if (++local.freeCount < LOCAL_FREE_MAX)
+            return;
+
+        // Hand the whole cache back so the submitting thread can reuse it
+        TaskSlot* last = local.freeSlots;
+        while (last->next)
+            last = last->next;
+
+        std::lock_guard<std::mutex> lock(slot_mutex);
+        last->next = freeSlots;
+        freeSlots = local.freeSlots;
+        local.freeSlots = nullptr;
+        local.freeCount = 0;
+    }
+
+    // Checked before any slot is taken, so a refused submit leaks none
+    void ensureRunning() const
+    {
+        if (stop)
+            throw std::runtime_error("submit on stopped ThreadPool");
+    }
+
+    // Queues the chain first..last of `count` filled slots
+    void push(TaskSlot* first, TaskSlot* last, const size_t count, const Lane lane)
+    {
+        // Counted before publishing: a worker may take a task and decrement
+        // before this call returns
+        unfinished.fetch_add(count);
+        queued.fetch_add(count);
+
+        const int64_t now = nowNs();
+        for (TaskSlot* slot = first;; slot = slot->next) {
+            slot->queuedAt = now;
+            if (slot == last)
+                break;
+        }
+
+        // A worker keeps the streaming work it spawns; other lanes and what
+        // doesn't fit go to the shared queues
+        if (currentPool == this && mode == Mode::WorkStealing && lane == Lane::Streaming) {
+            WorkStealingDeque<TaskSlot*>& deque = locals[currentIndex].deque;
+            while (first) {
+                // Read the link first: once pushed the slot may already be running
+                TaskSlot* next = first == last ? nullptr : first->next;
+                if (!deque.push(first))
+                    break;
+                first = next;
+            }
+        }
+        if (first) {
+            size_t shared = 1;
+            for (TaskSlot* slot = first; slot != last; slot = slot->next)
+                ++shared;
+            last->next = nullptr;
+
+            LaneQueue& queue = lanes[static_cast<size_t>(lane)];
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (queue.tail)
+                queue.tail->next = first;
+            else
+                queue.head = first;
+            queue.tail = last;
+            queue.depth.fetch_add(shared);
+        }
+
+        // Only wake sleepers if there are any: one for a single task, all of
+        // them for a batch, in one call either way
+        if (sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            if (count == 1)
+                sleep_cv.notify_one();
+            else
+                sleep_cv.notify_all();
+        }
+    }
+
+    TaskSlot* popLane(const Lane lane)
+    {
+        LaneQueue& queue = lanes[static_cast<size_t>(lane)];
+        if (queue.depth.load() == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        TaskSlot* task = queue.head;
+        if (task) {
+            queue.head = task->next;
+            if (!queue.head)
+                queue.tail = nullptr;
+            queue.depth.fetch_sub(1);
+        }
+        return task;
+    }
+
+    // Streaming work also lives on the worker deques: own first, then stolen
+    TaskSlot* takeFrom(const Lane lane, const size_t index)
+    {
+        if (lane != Lane::Streaming || mode != Mode::WorkStealing)
+            return popLane(lane);
+
+        TaskSlot* task = locals[index].deque.pop();
+        if (!task)
+            task = popLane(lane);
+        for (size_t n = 1; n < locals.size() && !task; ++n) {
+            task = locals[(index + n) % locals.size()].deque.steal();
+            if (task)
+                bump(locals[index].steals, uint64_t{1});
+        }
+        return task;
+    }
+
+    TaskSlot* findTask(const size_t index)
+    {
+        // Strict: lanes in order. Weighted: the lane whose turn it is goes
+        // first, then the rest in order
+        size_t first = 0;
+        if (lanePolicy.load(std::memory_order_relaxed) == LanePolicy::Weighted) {
+            uint32_t turn = locals[index].turn++ % (LANE_WEIGHTS[0] + LANE_WEIGHTS[1] + LANE_WEIGHTS[2]);
+            while (turn >= LANE_WEIGHTS[first])
+                turn -= LANE_WEIGHTS[first++];
+        }
+
+        TaskSlot* task = takeFrom(static_cast<Lane>(first), index);
+        for (size_t lane = 0; lane < LANE_COUNT && !task; ++lane) {
+            if (lane != first)
+                task = takeFrom(static_cast<Lane>(lane), index);
+        }
+
+        if (task)
+            queued.fetch_sub(1);
+        return task;
+    }
+
+    void workerLoop(const size_t index)
+    {
+        currentPool = this;
+        currentIndex = index;
+        Local& local = locals[index];
+        int64_t lastEnd = nowNs();
+
+        for (;;) {
+            if (TaskSlot* task = findTask(index)) {
+                const int64_t start = nowNs();
+                const uint64_t waitUs = static_cast<uint64_t>(std::max<int64_t>(start - task->queuedAt, 0)) / 1000;
+                size_t bucket = 0;
+                while (bucket < WAIT_BUCKETS - 1 && waitUs >= (uint64_t{8} << bucket))
+                    ++bucket;
+                bump(local.wait[task->tag][bucket], uint64_t{1});
+                bump(local.idleNs, start - lastEnd);
+
+                task->run(*task);
+                releaseSlot(index, task);
+
+                lastEnd = nowNs();
+                bump(local.busyNs, lastEnd - start);
+                bump(local.tasks, uint64_t{1});
+
+                if (unfinished.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    done_cv.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleepers.fetch_add(1);
+            sleep_cv.wait(lock, [this] {
+                return stop || queued.load() > 0;
+            });
+            sleepers.fetch_sub(1);
+
+            if (stop && queued.load() == 0)
+                return;
+        }
+    }
+
+    const Mode mode;
     std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
+    std::vector<Local> locals;
 
+    // Shared injection queues, one per lane, linked through TaskSlot::next
+    std::array<LaneQueue, LANE_COUNT> lanes;
     std::mutex queue_mutex;
-    std::condition_variable condition;
+    std::atomic<LanePolicy> lanePolicy{LanePolicy::Weighted};
+
+    std::vector<std::unique_ptr<TaskSlot[]>> slotBlocks;
+    TaskSlot* freeSlots = nullptr;
+    std::mutex slot_mutex;
+
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    std::atomic<size_t> sleepers{0};
+    std::atomic<size_t> queued{0};      // pushed, not yet taken
+    std::atomic<bool> stop{false};
+
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    std::atomic<size_t> unfinished{0};  // pushed, not yet finished
 
-    bool stop;
-    std::atomic<size_t> active_tasks;
+    struct {
+        std::atomic<size_t> submitted{0};
+        std::atomic<size_t> enqueued{0};
+        std::atomic<size_t> slots{0};
+        std::atomic<size_t> heapCallables{0};
+    } counters;
 };
 
 #endif // THREAD_POOL_HPP
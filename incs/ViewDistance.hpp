@@ -0,0 +1,46 @@
+#ifndef VIEW_DISTANCE_HPP
+#define VIEW_DISTANCE_HPP
+
+#include <cstddef>
+#include <string>
+
+// Picks the streaming radius from how the last second went: frame time,
+// how far behind the workers are and how much chunk memory is resident.
+// Moves one ring at a time, with a dead band and a cooldown so it settles.
+class ViewDistanceController {
+public:
+	struct Config {
+		int minRadius;
+		int maxRadius;
+		float targetFrameMs = 1000.0f / 60.0f;
+		size_t memoryCeiling = size_t{1024} << 20;
+		size_t maxQueuedJobs = 64;		// don't grow while the backlog is this deep
+	};
+
+	ViewDistanceController(int radius, const Config& config);
+	~ViewDistanceController() = default;
+
+	// Call once per frame with the time since the last one and the CPU time
+	// of the last one, start to swap: with vsync on the former never drops
+	// below the refresh interval. Returns the radius to stream at
+	int update(float frameSeconds, float cpuFrameSeconds, size_t queuedJobs, size_t residentBytes);
+
+	[[nodiscard]] int radius() const { return current; }
+	[[nodiscard]] float averageFrameMs() const { return avgFrameMs; }	// CPU time
+	[[nodiscard]] const std::string& reason() const { return lastReason; }
+
+private:
+	static constexpr float SHRINK_FACTOR = 1.15f;	// over target by this much shrinks
+	static constexpr float GROW_FACTOR = 0.75f;		// under target by this much grows
+	static constexpr float EVAL_INTERVAL = 1.0f;	// seconds between decisions
+	static constexpr float COOLDOWN = 2.0f;			// seconds after a change
+
+	Config config;
+	int current;
+	float avgFrameMs = 0.0f;
+	float sinceEval = 0.0f;
+	float sinceChange = 0.0f;
+	std::string lastReason = "initial";
+};
+
+#endif
@@ -3,12 +3,19 @@
 
 #include "defines.hpp"
 #include "ThreadPool.hpp"
+#include "MPSCQueue.hpp"
+#include "ScratchArena.hpp"
 #include "Camera.hpp"
 #include "Terrain.hpp"
 
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <optional>
+#include <memory>
+#include <deque>
+#include <unordered_set>
+#include <span>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -81,94 +88,344 @@ class Frustum {
 
 constexpr int MAX_FACES = Chunk::WIDTH * Chunk::HEIGHT * Chunk::DEPTH * 6;
 
-enum class ChunkState : uint8_t {
-	Unloaded,
-	Loading,
-	Loaded,
-	Meshing,
-	Unloading
-};
-
 enum class RenderType : uint8_t {
 	Air,
 	Opaque,
 	Transparent
 };
 
+// A side face of a chunk as its neighbours' meshers see it: block and
+// render type per cell, [y][cell] with cell = z on X faces, x on Z faces.
+// Retaken from the voxels once the chunk's edge version moves past it
+struct EdgeSlice {
+	static constexpr int CELLS = Chunk::WIDTH;
+	static_assert(Chunk::WIDTH == Chunk::DEPTH);
+
+	uint32_t version = 0;
+	std::array<uint8_t, Chunk::HEIGHT * CELLS> types{};
+	std::array<RenderType, Chunk::HEIGHT * CELLS> render{};
+};
+using EdgeSlices = std::array<EdgeSlice, Chunk::FACES>;
+
+// Pipeline stages. A chunk is meshed only once its four side neighbours are
+// generated, so borders always see real voxels.
+enum class ChunkState : uint8_t {
+	Loading,			// queued or generating terrain
+	Generated,			// voxels present, waiting on neighbours or to be seen
+	NeighboursReady,	// mesh job queued or running
+	Meshed,				// mesh waiting for upload
+	Uploaded
+};
+
+// One entry per chunk the streamer currently wants; absent means unloaded.
+// Guarded by World::chunk_mutex. The generation is unique per request, so a
+// job holding an older one knows its result is no longer wanted.
+struct ChunkRecord {
+	ChunkState state = ChunkState::Loading;
+	uint8_t missingNeighbours = 0;		// side neighbours not generated, while Generated
+	uint32_t generation = 0;
+	size_t bytes = 0;					// voxels, CPU mesh and GPU buffers
+	double lastVisible = 0.0;			// last frame it passed the frustum test
+	double editedAt = 0.0;				// oldest edit no mesh job has picked up, 0 if none
+	double meshedEditAt = 0.0;			// oldest edit in an installed mesh not yet uploaded
+	Chunk::SectionMask remeshSections = Chunk::ALL_SECTIONS;	// what the next mesh job rebuilds
+	std::unique_ptr<Chunk> chunk;		// null until the load lands
+	std::unique_ptr<EdgeSlices> edges;	// taken when a neighbour first meshes against it
+	Chunk::ChunkRenderData mesh;		// GL handles, render thread only
+};
+
 struct WorldUBO {
 	glm::mat4 MVP;
 	glm::vec4 light;       // xyz = pos, w = radius
 	glm::vec4 cameraPos;   // xyz = pos, w = ambient
+	glm::vec4 fog;         // x = start, y = end (XZ distance)
 };
 
 struct MaskEntry
 {
 	bool visible;
 	uint8_t blockType;
+	uint8_t ao;		// ChunkQuad corner order; faces only merge when it matches
 };
 
+// Quads land in the meshing thread's scratch arena, grouped by section
+// once meshing is done
 struct MeshTarget
 {
-	std::vector<Vertex>& vertices;
-	std::vector<uint32_t>& indices;
+	ScratchVector<ChunkQuad>& quads;
+	std::array<uint32_t, Chunk::SECTIONS>& sectionQuads;
+};
+
+// Both produce the same quads in the same order
+enum class Mesher : uint8_t {
+	Scalar,		// MaskEntry slices, cell by cell
+	Binary		// column bitmasks, shifts and bit scans
+};
+
+// A chunk waiting for a worker, ordered by priority (lower is more urgent)
+struct PendingChunk
+{
+	ChunkCoord coord;
+	float priority;
+	double requestedAt;
+	uint32_t generation;
+	bool inView;
+};
+
+// Pushed by workers when a chunk has a new mesh for the render thread
+struct MeshUpload
+{
+	ChunkCoord coord;
+	uint32_t version;
+};
+
+struct StreamingStats
+{
+	size_t pendingLoads = 0;
+	float avgTimeToVisible = 0.0f;   // seconds, chunks requested while in view
+	float lastTimeToVisible = 0.0f;
+	uint64_t visibleLoads = 0;
+	uint64_t cancelledLoads = 0;      // dropped before any work was done
+	uint64_t wastedGenerations = 0;   // generated, then thrown away
+	uint64_t usefulGenerations = 0;
+	size_t prefetchedChunks = 0;      // requested ahead of the load disc
+	size_t awaitingView = 0;          // generated and meshable, not meshed until seen
+	float speed = 0.0f;               // blocks per second, XZ
+	size_t residentBytes = 0;
+	size_t memoryBudget = 0;
+	uint64_t evictedChunks = 0;
 };
 
 // Define the world as a collection of chunks
 class World {
 	public:
-		constexpr static int CHUNK_RADIUS = 16;
-		constexpr static int CHUNK_DIAMETER = CHUNK_RADIUS * 2 + 1;
+		constexpr static int DEFAULT_CHUNK_RADIUS = 16;
+		constexpr static int MIN_CHUNK_RADIUS = 4;
+		constexpr static int MAX_CHUNK_RADIUS = 32;
+		// Chunks load inside loadDistance(); pending loads are only dropped
+		// once past unloadDistance(), so walking along a border does not thrash
+		constexpr static int LOAD_MARGIN = 1;
+		constexpr static int UNLOAD_MARGIN = 2;
+		constexpr static float RERANK_VIEW_DOT = 0.985f;	// ~10 degrees
+		// Prefetch follows the extrapolated path for PREFETCH_SECONDS, at most
+		// PREFETCH_MAX_AHEAD chunks past the load disc and PREFETCH_BUDGET
+		// chunks in total
+		constexpr static float PREFETCH_SECONDS = 3.0f;
+		constexpr static float PREFETCH_MIN_SPEED = 20.0f;	// blocks per second
+		constexpr static int PREFETCH_MAX_AHEAD = 12;
+		constexpr static int PREFETCH_HALF_WIDTH = 2;
+		constexpr static size_t PREFETCH_BUDGET = 192;
+		constexpr static float PRIORITY_LEAD_SECONDS = 0.75f;
+		constexpr static double MOTION_WINDOW = 0.5;	// seconds of position history
+		// Eviction score: one chunk of distance per two seconds unseen
+		constexpr static size_t DEFAULT_MEMORY_BUDGET = size_t{1024} << 20;
+		constexpr static float EVICT_UNSEEN_WEIGHT = 0.5f;
+		constexpr static float EVICT_EDITED_FACTOR = 0.25f;
+		// Meshes are built once a chunk is within LAZY_MESH_NEAR chunks or its
+		// box, grown by LAZY_MESH_MARGIN blocks, touches the frustum
+		constexpr static int LAZY_MESH_NEAR = 2;
+		constexpr static float LAZY_MESH_MARGIN = Chunk::WIDTH * 2.0f;
+		constexpr static int MESHER_BLOCK_TYPES = 16;	// block types the binary mesher keeps masks for
+		constexpr static size_t MESH_SCRATCH_QUADS = 4096;	// per target before its scratch buffer grows
 
 		Frustum frustum{};
 		WorldUBO worldUBO{};
 		GLuint ubo;
 
 		std::mutex chunk_mutex;
-		std::mutex state_mutex;
+		std::mutex schedule_mutex;
+		bool predictionEnabled = true;	// main thread only
+		std::atomic<Mesher> mesher{Mesher::Binary};	// read by mesh jobs
 
 		World(std::array<uint32_t, 256>& indices);
 		~World() = default;
 		World(const World&) = delete;
 		World& operator=(const World&) = delete;
 
-		void updateChunks(const glm::vec3& playerPos, ThreadPool& threadPool);
+		void updateChunks(const Camera& camera, ThreadPool& threadPool);
+		void recordTimeToVisible(const Chunk& chunk);
+		void markChunkDirty(const ChunkCoord& coord, Chunk::SectionMask sections);	// caller holds chunk_mutex
+		void remeshAll(ThreadPool& threadPool);			// every meshed chunk, on the streaming lane
+		MPSCQueue<MeshUpload>& getCompletedMeshes() { return completedMeshes; }
+		MPSCQueue<MeshUpload>& getCompletedEdits() { return completedEdits; }
+		[[nodiscard]] StreamingStats getStreamingStats();
+		[[nodiscard]] int getChunkRadius() const { return chunkRadius; }
+		void setChunkRadius(int radius);	// applied on the next updateChunks
+		[[nodiscard]] float getFarPlane() const;
+		[[nodiscard]] size_t getMemoryBudget() const { return memoryBudget; }
+		void setMemoryBudget(const size_t bytes) { memoryBudget = bytes; }
+		void updateRecordBytes(ChunkRecord& record);	// caller holds chunk_mutex
+		static void releaseMesh(Chunk::ChunkRenderData& mesh);	// render thread
+		void setEagerMeshRadius(const int radius) { eagerMeshRadius.store(radius, std::memory_order_relaxed); }
 		// void generateChunkMesh(Chunk& chunk, const ChunkCoord& coord) const;
-		void generateChunkGreedyMesh(Chunk& chunk, const ChunkCoord& coord);
+		void generateChunkGreedyMesh(Chunk& chunk, const ChunkCoord& coord, Mesher kind);
+		// Quads of a contiguous run of sections of `voxels` at coord, valid until
+		// the caller's ScratchArena::Scope closes. Only the layers of those
+		// sections and one either side are read
+		void buildGreedyMesh(std::span<const Voxel, Chunk::SIZE> voxels, const ChunkCoord& coord, Mesher kind,
+			Chunk::SectionMask sections, MeshTarget opaque, MeshTarget transparent);
 		bool isBlockActiveWorld(int wx, int wy, int wz) const;
 		bool isBoxInFrustum(const glm::vec3& min, const glm::vec3& max) const;
 		void updateFrustum(const glm::mat4& proj_mat, const glm::mat4& view_mat);
-		std::unordered_map<ChunkCoord, Chunk>& getChunks() { return chunks; }
-		const std::unordered_map<ChunkCoord, Chunk>& getChunks() const { return chunks; }
-		std::unordered_map<ChunkCoord, std::atomic<ChunkState>>& getChunkStates() { return chunkStates; }
-		const std::unordered_map<ChunkCoord, std::atomic<ChunkState>>& getChunkStates() const { return chunkStates; }
-
+		std::unordered_map<ChunkCoord, ChunkRecord>& getChunks() { return chunks; }
+		const std::unordered_map<ChunkCoord, ChunkRecord>& getChunks() const { return chunks; }
+		[[nodiscard]] Chunk* findChunk(const ChunkCoord& coord);	// caller holds chunk_mutex
+		const EdgeSlice* edgeSlice(const ChunkCoord& coord, Chunk::Face face);	// caller holds chunk_mutex
+		[[nodiscard]] const Chunk* findChunk(const ChunkCoord& coord) const;
+
+		// Both mesh opaque and water faces in one traversal, only over the
+		// layers yMin..yMax that hold blocks
 		void runGreedyPass(
-			RenderType targetType,
 			RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
 			uint8_t blockTypes[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
-			MeshTarget target
+			MeshTarget opaque,
+			MeshTarget transparent,
+			int yMin, int yMax
 		) const;
 
+		// Block types present are all below typeCount; only their masks are cleared
+		void runBinaryPasses(
+			const RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
+			const uint8_t blockTypes[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
+			MeshTarget opaque,
+			MeshTarget transparent,
+			int yMin, int yMax,
+			int typeCount
+		) const;
+
+		// One merged w x h face at pos, spanning the two axes after `axis`
+		static void emitGreedyQuad(MeshTarget target, int axis, int dir, const int pos[3], int w, int h, uint16_t tex, uint8_t ao);
+
+		// Corner AO of the opaque face of `cell` toward dir, from the opaque
+		// blocks around the cell on the open side; ChunkQuad corner order
+		static uint8_t faceAO(
+			const RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
+			int axis, int dir, const int cell[3]
+		);
+
 		static void buildMask(
-			RenderType targetType,
 			int axis,
 			RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
 			uint8_t blockTypes[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
-			const int dims[3],
+			const int lo[3], const int size[3],
 			int x[3], const int q[3],
-			std::vector<MaskEntry>& mask
+			MaskEntry* mask
 		);
 
 		static void generateTerrain(Chunk& chunk, const ChunkCoord& coord);
 
 	private:
-		ChunkCoord playerChunk = {std::numeric_limits<int>::max(),std::numeric_limits<int>::max()};
+		void requestLoads(const std::vector<ChunkCoord>& coords, const Camera& camera, ThreadPool& threadPool);
+		void unloadChunks(const std::vector<ChunkCoord>& coords);
+		void remeshDirtyChunks(ThreadPool& threadPool);
+		void meshChunk(const ChunkCoord& coord, uint32_t generation);
+		void scheduleMeshes(std::span<const ChunkCoord> ready, ThreadPool& threadPool,
+			ThreadPool::Lane lane = ThreadPool::Lane::Streaming);
+		void meshChunksEnteringView(ThreadPool& threadPool);
+		[[nodiscard]] bool isNearPlayer(const ChunkCoord& coord) const;
+		void loadNextChunk(ThreadPool& threadPool);
+		bool isLoadWanted(const ChunkCoord& coord, uint32_t generation);
+		void reprioritisePendingLoads(const Camera& camera);
+		float loadPriority(const ChunkCoord& coord, const glm::vec3& camPos, const glm::vec3& camDir, bool& inView) const;
+		void trackMotion(const glm::vec3& pos);
+		void prefetchAlongPath(const Camera& camera, const ChunkCoord& center, std::vector<ChunkCoord>& toLoad);
+		void enforceMemoryBudget(const ChunkCoord& center);
+		[[nodiscard]] static float evictionScore(const ChunkCoord& coord, const ChunkRecord& record,
+			const ChunkCoord& center, double now);
+		[[nodiscard]] int loadDistance() const { return chunkRadius + LOAD_MARGIN; }
+		[[nodiscard]] int unloadDistance() const { return chunkRadius + LOAD_MARGIN + UNLOAD_MARGIN; }
+
+		std::atomic<ChunkCoord> playerChunk = ChunkCoord{std::numeric_limits<int>::max(),std::numeric_limits<int>::max()};
 		std::array<uint32_t, 256>& textureIndices;
-		std::unordered_map<ChunkCoord, Chunk> chunks;
-		std::unordered_map<ChunkCoord, std::atomic<ChunkState>> chunkStates;
+		std::unordered_map<ChunkCoord, ChunkRecord> chunks;
+		uint32_t nextGeneration = 1;	// guarded by chunk_mutex
+		std::atomic<size_t> residentBytes{0};	// sum of record bytes, written under chunk_mutex
+		size_t memoryBudget = DEFAULT_MEMORY_BUDGET;
+		uint64_t evictedChunks = 0;
+
+		int chunkRadius = DEFAULT_CHUNK_RADIUS;	// main thread only
+		int streamRadius = DEFAULT_CHUNK_RADIUS;	// radius the resident set was built for
+		std::optional<ChunkCoord> streamCenter;	// main thread only
+		glm::vec3 rankedViewDir{0.0f};
+		std::deque<std::pair<double, glm::vec2>> motionHistory;	// main thread only
+		glm::vec2 velocity{0.0f};						// XZ blocks per second
+		std::unordered_set<ChunkCoord> prefetched;		// main thread only
+		bool prefetchWasEnabled = true;
+		std::vector<ChunkCoord> dirtyChunks;	// guarded by chunk_mutex
+		std::unordered_set<ChunkCoord> awaitingView;	// meshable, not yet seen; guarded by chunk_mutex
+		std::atomic<int> eagerMeshRadius{0};			// meshed regardless of view, e.g. during warm-up
+		MPSCQueue<MeshUpload> completedMeshes;
+		MPSCQueue<MeshUpload> completedEdits;			// meshes carrying a block edit, uploaded first
+
+		std::vector<PendingChunk> pendingLoads;	// min-heap on priority, guarded by schedule_mutex
+		StreamingStats stats;
+		std::atomic<uint64_t> cancelledLoads{0};
+		std::atomic<uint64_t> wastedGenerations{0};
+		std::atomic<uint64_t> usefulGenerations{0};
+
+};
 
+inline const std::array<ChunkCoord, 4> SIDE_OFFSETS = {
+	ChunkCoord(-1, 0), ChunkCoord(1, 0), ChunkCoord(0, -1), ChunkCoord(0, 1)
 };
 
+inline bool isWithinDistance(const ChunkCoord& c, const ChunkCoord& center, const int distance)
+{
+	const int64_t dx = static_cast<int64_t>(c.x) - center.x;
+	const int64_t dz = static_cast<int64_t>(c.y) - center.y;
+	return dx * dx + dz * dz <= static_cast<int64_t>(distance) * distance;
+}
+
+// Largest |dz| still within `distance` in the column `dx` away from the center
+inline int ringHalfSpan(const int distance, const int dx)
+{
+	return static_cast<int>(std::sqrt(static_cast<float>(distance * distance - dx * dx)));
+}
+
+// Visits every coord within `distance` of `to` that was not within `distance`
+// of `from`, one z-span per column, so the cost is the size of the ring
+template<typename F>
+void forEachRingDelta(const std::optional<ChunkCoord>& from, const ChunkCoord& to, const int distance, F&& fn)
+{
+	for (int dx = -distance; dx <= distance; ++dx) {
+		const int x = to.x + dx;
+		const int h = ringHalfSpan(distance, dx);
+
+		int skipLo = 1, skipHi = 0;
+		if (from && std::abs(x - from->x) <= distance) {
+			const int fh = ringHalfSpan(distance, x - from->x);
+			skipLo = from->y - fh;
+			skipHi = from->y + fh;
+		}
+
+		for (int z = to.y - h; z <= to.y + h; ++z) {
+			if (z >= skipLo && z <= skipHi) {
+				z = skipHi;
+				continue;
+			}
+			fn(ChunkCoord(x, z));
+		}
+	}
+}
+
+// Visits every coord within `outer` of `center` that is not within `inner`
+template<typename F>
+void forEachRadiusDelta(const ChunkCoord& center, const int inner, const int outer, F&& fn)
+{
+	for (int dx = -outer; dx <= outer; ++dx) {
+		const int h = ringHalfSpan(outer, dx);
+		const int skip = std::abs(dx) <= inner ? ringHalfSpan(inner, dx) : -1;
+
+		for (int dz = -h; dz <= h; ++dz) {
+			if (std::abs(dz) <= skip) {
+				dz = skip;
+				continue;
+			}
+			fn(center + ChunkCoord(dx, dz));
+		}
+	}
+}
+
 template<typename F>
 void forEachChunkSpiral(const ChunkCoord& center, const int radius, F&& fn)
 {
@@ -1,6 +1,11 @@
 #include "App.hpp"
+#include "ChunkNeighborhood.hpp"
 
 #include <iostream>
+#include <cstring>
+#include <cmath>
+#include <bit>
+#include <utility>
 
 #include <imgui.h>
 #include <ranges>
@@ -69,13 +74,20 @@ static void handleMovement(const GLFWwindow* window, std::unique_ptr<Camera>& ca
 }
 
 App::App(const int32_t width, const int32_t height, const char *title, std::map<settings_t, bool>& settings)
-	: Engine(width, height, title, settings), textureIndices(), world(textureIndices)
+	: Engine(width, height, title, settings), textureIndices(), world(textureIndices),
+	  viewDistance(World::DEFAULT_CHUNK_RADIUS, {
+		  .minRadius = World::MIN_CHUNK_RADIUS,
+		  .maxRadius = World::MAX_CHUNK_RADIUS,
+		  .memoryCeiling = World::DEFAULT_MEMORY_BUDGET,
+	  })
 {
 	showWireframe = false;
 	focused = true;
 	setCallbackFunctions();
 	loadTextures();
 	threadPool = std::make_unique<ThreadPool>(8);
+	setupQuadIndices();
+	glCreateVertexArrays(1, &emptyVAO);
 	setupHighlightCube();
 	setupImGui(window);
 }
@@ -83,6 +95,8 @@ App::App(const int32_t width, const int32_t height, const char *title, std::map<
 App::~App()
 {
 	cleanupHighlightCube();
+	glDeleteBuffers(1, &quadIndexBuffer);
+	glDeleteVertexArrays(1, &emptyVAO);
 	App::terminate();
 }
 
@@ -101,66 +115,209 @@ void App::run()
     float rgba[4] = {0.075f, 0.33f, 0.61f, 1.f};
     // float rgba[4] = {};
 
+    glClearColor(rgba[0], rgba[1], rgba[2], rgba[3]);
+    warmUp();
+
     while (windowIsOpen(window))
     {
         glClearColor(rgba[0], rgba[1], rgba[2], rgba[3]);
+        const auto frameStart = std::chrono::steady_clock::now();
         glfwPollEvents();
         FPSCounter::update();
-        handleMovement(window, camera);
+        if (flythrough.active)
+        	updateFlythrough(FPSCounter::getDeltaTime());
+        else
+        	handleMovement(window, camera);
 
-        Renderer::initProjectionMatrix(window, camera, world.worldUBO.MVP);
+        Renderer::initProjectionMatrix(window, camera, world.worldUBO.MVP, world.getFarPlane());
 
     	world.worldUBO.cameraPos = glm::vec4(camera->pos, world.worldUBO.cameraPos.w);
         world.updateFrustum(camera->proj, camera->view);
-        world.updateChunks(camera->pos, *threadPool);
+        world.updateChunks(*camera, *threadPool);
 
     	updateBlockHighlight();
-
+    	integrateMeshes(MESH_UPLOAD_BUDGET_MS);
+    	if (flythrough.active && !flythrough.settling)
+    		flythrough.holes += countVisibleHoles();
+    	// Lazy meshing and eviction can keep the disc from ever filling up,
+    	// so the walk over it stops after a while
+    	if (startup.fullyPopulatedSeconds < 0.0f && secondsSince(startup.processStart) < STARTUP_POPULATE_TIMEOUT
+    		&& countVisibleHoles() == 0)
+    		startup.fullyPopulatedSeconds = secondsSince(startup.processStart);
+
+        // Memory the view disc itself needs; cached chunks outside it are
+        // the world budget's business, not the radius controller's
+        size_t discBytes = 0;
         {
-	        std::vector<Chunk*> visibleChunks;
 	        std::lock_guard lock(world.chunk_mutex);
-        	auto& chunks = world.getChunks();
-        	visibleChunks.reserve(chunks.size());
-
-        	for (auto& [coord, chunk] : chunks) {
-        		if (!world.isBoxInFrustum(chunk.worldMin, chunk.worldMax))
-        			continue;
-
-        		if (!chunk.aoCalculated)
-        			calcChunkAO(coord, chunk, world);
-
-        		if (!chunk.cachedOpaqueVertices.empty() || !chunk.cachedTransparentVertices.empty())
-        			uploadChunk(chunk, chunk.renderData);
+        	discBytes = cullChunks();
 
-        		if (chunk.renderData.opaque.vao || chunk.renderData.transparent.vao)
-        			visibleChunks.push_back(&chunk);
+        	for (const auto& record : visibleChunks | std::views::values) {
+        		renderChunk(record->mesh, world.worldUBO, world.ubo, RenderType::Opaque);
         	}
 
-        	glm::vec3 camPos = camera->pos;
-        	std::sort(visibleChunks.begin(), visibleChunks.end(),
-				[&camPos](const Chunk* a, const Chunk* b) {
-					const auto worldCenterA = (a->worldMin + a->worldMax) * 0.5f;
-					const auto worldCenterB = (b->worldMin + b->worldMax) * 0.5f;
-					return glm::distance2(worldCenterA, camPos) < glm::distance2(worldCenterB, camPos);
-				});
-
-        	for (const auto& chunk : visibleChunks) {
-        		renderChunk(*chunk, world.worldUBO, world.ubo, RenderType::Opaque);
-        	}
-
-        	for (const auto& chunk : visibleChunks) {
-        		renderChunk(*chunk, world.worldUBO, world.ubo, RenderType::Transparent);
+        	for (const auto& record : visibleChunks | std::views::values) {
+        		renderChunk(record->mesh, world.worldUBO, world.ubo, RenderType::Transparent);
         	}
 	    }
 
     	renderBlockHighlight();
-        renderImGui(camera, showWireframe, rgba, world.getChunks().size());
+    	// Hold the radius still while measuring
+    	if (!flythrough.active)
+    		world.setChunkRadius(viewDistance.update(FPSCounter::getDeltaTime(), cpuFrameSeconds,
+    			threadPool->pendingTasks(), discBytes));
+        renderImGui(camera, showWireframe, rgba, debugStats());
+        // The swap waits for vsync, so frame cost is measured up to it
+        cpuFrameSeconds = secondsSince(frameStart);
         glfwSwapBuffers(window);
+        if (startup.firstPlayableSeconds < 0.0f)
+        	startup.firstPlayableSeconds = secondsSince(startup.processStart);
 	}
 
 	threadPool->wait();
 }
 
+DebugStats App::debugStats()
+{
+	return {
+		.chunkCount = world.getChunks().size(),
+		.streaming = world.getStreamingStats(),
+		.tasks = threadPool->stats(),
+		.telemetry = threadPool->telemetry(),
+		.lanePolicy = threadPool->getLanePolicy(),
+		.scratch = ScratchArena::stats(),
+		.prediction = world.predictionEnabled,
+		.mesher = world.mesher.load(),
+		.quadPulling = quadPulling,
+		.uploads = uploadStats,
+		.viewDistance = viewDistance,
+		.flythrough = flythrough,
+		.queries = queryBenchmark,
+		.startup = startup,
+		.pool = poolBenchmark,
+		.edits = editLatency,
+		.culling = cullStats,
+		.meshers = mesherBenchmark,
+	};
+}
+
+size_t App::cullChunks()
+{
+	const auto start = std::chrono::steady_clock::now();
+	auto& chunks = world.getChunks();
+
+	// The map can't be split across threads; a flat list of entries can
+	frameRecords.clear();
+	for (auto& entry : chunks)
+		frameRecords.push_back(&entry);
+	frameDistances.resize(frameRecords.size());
+
+	const ChunkCoord center(
+		floorDiv(static_cast<int>(camera->pos.x), Chunk::WIDTH),
+		floorDiv(static_cast<int>(camera->pos.z), Chunk::DEPTH));
+	const int discDistance = world.getChunkRadius() + World::LOAD_MARGIN;
+	const double now = glfwGetTime();
+	const glm::vec3 camPos = camera->pos;
+
+	// Each entry is touched by exactly one thread; the distance doubles as
+	// the sort key, negative when the chunk is not drawn
+	auto cull = [&](const size_t lo, const size_t hi) {
+		size_t bytes = 0;
+		for (size_t i = lo; i < hi; ++i) {
+			auto& [coord, record] = *frameRecords[i];
+			frameDistances[i] = -1.0f;
+
+			if (isWithinDistance(coord, center, discDistance))
+				bytes += record.bytes;
+
+			if (!record.chunk)
+				continue;
+
+			Chunk& chunk = *record.chunk;
+			if (!world.isBoxInFrustum(chunk.worldMin, chunk.worldMax))
+				continue;
+
+			record.lastVisible = now;
+
+			if (record.mesh.opaque.vbo || record.mesh.transparent.vbo) {
+				if (!chunk.seenVisible) {
+					chunk.seenVisible = true;
+					world.recordTimeToVisible(chunk);
+				}
+				frameDistances[i] = glm::distance2((chunk.worldMin + chunk.worldMax) * 0.5f, camPos);
+			}
+		}
+		return bytes;
+	};
+
+	const size_t discBytes = cullStats.parallel
+		? threadPool->parallel_reduce(size_t{0}, frameRecords.size(), CULL_GRAIN, size_t{0}, cull, std::plus<>{})
+		: cull(0, frameRecords.size());
+
+	visibleChunks.clear();
+	for (size_t i = 0; i < frameRecords.size(); ++i) {
+		if (frameDistances[i] >= 0.0f)
+			visibleChunks.emplace_back(frameDistances[i], &frameRecords[i]->second);
+	}
+	std::sort(visibleChunks.begin(), visibleChunks.end(),
+		[](const auto& a, const auto& b) { return a.first < b.first; });
+
+	float& avg = cullStats.avgMs[cullStats.parallel];
+	const float ms = secondsSince(start) * 1000.0f;
+	avg = avg > 0.0f ? avg + (ms - avg) * 0.05f : ms;
+	cullStats.chunks = frameRecords.size();
+	return discBytes;
+}
+
+void App::toggleParallelCulling()
+{
+	cullStats.parallel = !cullStats.parallel;
+}
+
+void App::warmUp()
+{
+	const auto begin = std::chrono::steady_clock::now();
+	const int rings = std::min(WARMUP_RINGS, world.getChunkRadius());
+	const ChunkCoord center(
+		floorDiv(static_cast<int>(camera->pos.x), Chunk::WIDTH),
+		floorDiv(static_cast<int>(camera->pos.z), Chunk::DEPTH));
+
+	size_t total = 0;
+	forEachRingDelta(std::nullopt, center, rings, [&](const ChunkCoord) { ++total; });
+
+	// The whole disc streams as usual, inner rings first; the warm-up rings
+	// are meshed regardless of where the camera looks
+	world.setEagerMeshRadius(rings);
+
+	size_t done = 0;
+	while (windowIsOpen(window) && done < total)
+	{
+		glfwPollEvents();
+		FPSCounter::update();
+
+		Renderer::initProjectionMatrix(window, camera, world.worldUBO.MVP, world.getFarPlane());
+		world.updateFrustum(camera->proj, camera->view);
+		world.updateChunks(*camera, *threadPool);
+		integrateMeshes(WARMUP_UPLOAD_BUDGET_MS);
+
+		done = 0;
+		{
+			std::lock_guard lock(world.chunk_mutex);
+			const auto& chunks = world.getChunks();
+			forEachRingDelta(std::nullopt, center, rings, [&](const ChunkCoord c) {
+				if (const auto it = chunks.find(c); it != chunks.end() && it->second.state == ChunkState::Uploaded)
+					++done;
+			});
+		}
+
+		renderWarmUpImGui(done, total, secondsSince(begin));
+		glfwSwapBuffers(window);
+	}
+
+	world.setEagerMeshRadius(0);
+	startup.warmUpSeconds = secondsSince(begin);
+}
+
 void App::terminate()
 {
 	threadPool.reset();
@@ -209,67 +366,276 @@ void App::loadTextures() {
     }
 }
 
-static void uploadBatch(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, Chunk::RenderBatch& batch)
+// Non-empty sections get room to grow, so most edits fit their slot
+static uint32_t slotCapacity(const uint32_t quads)
 {
-	if (indices.empty()) return;
+	return quads ? quads + quads / 8 + App::SECTION_SLACK : 0;
+}
 
-	if (batch.vao == 0) glGenVertexArrays(1, &batch.vao);
-	if (batch.vbo == 0) batch.vbo = VBOManager::get().getVBO();
-	if (batch.ibo == 0) batch.ibo = VBOManager::get().getVBO();
+static size_t quadBytes(const bool pulled)
+{
+	return pulled ? sizeof(ChunkQuad) : 4 * sizeof(ChunkVertex);
+}
 
-	batch.indexCount = indices.size();
+// Writes quads from slot position `first` on into the buffer bound to GL_COPY_WRITE_BUFFER
+static size_t writeQuads(const ChunkQuad* quads, const uint32_t count, const uint32_t first, const bool pulled)
+{
+	if (count == 0)
+		return 0;
+
+	// The shader expands the quads itself: written as they are
+	if (pulled) {
+		glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * quadBytes(true)),
+			static_cast<GLsizeiptr>(count * quadBytes(true)), quads);
+		return count * quadBytes(true);
+	}
 
-	glBindVertexArray(batch.vao);
+	static std::vector<ChunkVertex> vertices;	// render thread only
+	vertices.clear();
+	for (uint32_t q = 0; q < count; ++q)
+		for (int k = 0; k < 4; ++k)
+			vertices.push_back(quads[q].vertex(k));
 
-	glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
-	glBufferData(
-		GL_ARRAY_BUFFER,
-		vertices.size() * sizeof(Vertex),
-		vertices.data(),
-		GL_DYNAMIC_DRAW
-	);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * quadBytes(false)),
+		static_cast<GLsizeiptr>(vertices.size() * sizeof(ChunkVertex)), vertices.data());
+	return vertices.size() * sizeof(ChunkVertex);
+}
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.ibo);
-	glBufferData(
-		GL_ELEMENT_ARRAY_BUFFER,
-		indices.size() * sizeof(uint32_t),
-		indices.data(),
-		GL_DYNAMIC_DRAW
-	);
+// Uploads the quads of `sections`, section by section in `quads`. Sections
+// that fit their slot are rewritten in place; otherwise the buffer is laid
+// out again, keeping the other sections with a GPU-side copy. Returns the
+// bytes sent from the CPU
+static size_t uploadBatch(const std::vector<ChunkQuad>& quads, const std::array<uint32_t, Chunk::SECTIONS>& counts,
+	const Chunk::SectionMask sections, const GLuint quadIndexBuffer, const bool pull, Chunk::RenderBatch& batch)
+{
+	std::array<uint32_t, Chunk::SECTIONS> from{};
+	for (int s = 1; s < Chunk::SECTIONS; ++s)
+		from[s] = from[s - 1] + counts[s - 1];
+
+	// A partial update stays in the format the buffer already has
+	const bool full = sections == Chunk::ALL_SECTIONS || batch.vbo == 0;
+	const bool pulled = full ? pull : batch.pulled;
+	const size_t stride = quadBytes(pulled);
+
+	bool fits = !full;
+	for (int s = 0; s < Chunk::SECTIONS && fits; ++s)
+		fits = !(sections >> s & 1) || counts[s] <= batch.sections[s].capacity;
+
+	size_t written = 0;
+	if (fits) {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, batch.vbo);
+		for (int s = 0; s < Chunk::SECTIONS; ++s) {
+			if (!(sections >> s & 1))
+				continue;
+			auto& slot = batch.sections[s];
+			batch.quadCount += counts[s] - slot.quads;
+			slot.quads = counts[s];
+			written += writeQuads(quads.data() + from[s], counts[s], slot.first, pulled);
+		}
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		return written;
+	}
 
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-		(void*)offsetof(Vertex, position));
+	std::array<Chunk::SectionSlot, Chunk::SECTIONS> slots{};
+	uint32_t total = 0;
+	uint32_t drawn = 0;
+	for (int s = 0; s < Chunk::SECTIONS; ++s) {
+		const uint32_t n = sections >> s & 1 ? counts[s] : batch.sections[s].quads;
+		slots[s] = {total, n, slotCapacity(n)};
+		total += slots[s].capacity;
+		drawn += n;
+	}
 
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-		(void*)offsetof(Vertex, uv));
+	batch.quadCount = drawn;
+	// Nothing left to draw: the buffer goes back to the pool rather than
+	// sitting on the GPU uncounted
+	if (total == 0) {
+		if (batch.vao)
+			glDeleteVertexArrays(1, &batch.vao);
+		if (batch.vbo)
+			VBOManager::get().returnVBO(batch.vbo);
+		batch = {};
+		return 0;
+	}
 
-	glEnableVertexAttribArray(2);
-	glVertexAttribIPointer(2, 1, GL_UNSIGNED_SHORT, sizeof(Vertex),
-		(void*)offsetof(Vertex, texIndex));
+	// A full upload orphans the old storage; a partial one still reads from it
+	const GLuint vbo = full && batch.vbo ? batch.vbo : VBOManager::get().getVBO();
+	glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+	glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(total * stride), nullptr, GL_DYNAMIC_DRAW);
+	if (!full) {
+		glBindBuffer(GL_COPY_READ_BUFFER, batch.vbo);
+		for (int s = 0; s < Chunk::SECTIONS; ++s)
+			if (!(sections >> s & 1) && slots[s].quads)
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+					static_cast<GLintptr>(batch.sections[s].first * stride), static_cast<GLintptr>(slots[s].first * stride),
+					static_cast<GLsizeiptr>(slots[s].quads * stride));
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	}
+	for (int s = 0; s < Chunk::SECTIONS; ++s)
+		if (sections >> s & 1)
+			written += writeQuads(quads.data() + from[s], counts[s], slots[s].first, pulled);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if (batch.vbo && batch.vbo != vbo)
+		VBOManager::get().returnVBO(batch.vbo);
+	batch.vbo = vbo;
+	batch.sections = slots;
+	batch.pulled = pulled;
+	batch.bytes = total * stride;
+
+	// Pulled batches read vbo as a storage buffer; nothing to bind
+	if (pulled) {
+		if (batch.vao) {
+			glDeleteVertexArrays(1, &batch.vao);
+			batch.vao = 0;
+		}
+		return written;
+	}
 
-	glEnableVertexAttribArray(3);
-	glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, sizeof(Vertex),
-		(void*)offsetof(Vertex, normal));
+	if (batch.vao == 0) glGenVertexArrays(1, &batch.vao);
 
-	glEnableVertexAttribArray(4);
-	glVertexAttribIPointer(4, 1, GL_UNSIGNED_BYTE, sizeof(Vertex),
-		(void*)offsetof(Vertex, ao));
+	glBindVertexArray(batch.vao);
+	glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndexBuffer);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(ChunkVertex), nullptr);
 
 	glBindVertexArray(0);
+	return written;
 }
 
-void App::uploadChunk(const Chunk& chunk, Chunk::ChunkRenderData& data)
+// The used part of every section slot in one multi-draw. Vertex batches go
+// out in QUADS_PER_DRAW slices, each rebased onto the shared indices
+static void drawSections(const Chunk::RenderBatch& batch)
 {
-	uploadBatch(chunk.cachedOpaqueVertices, chunk.cachedOpaqueIndices, data.opaque);
-	uploadBatch(chunk.cachedTransparentVertices, chunk.cachedTransparentIndices, data.transparent);
+	constexpr uint32_t MAX_SECTION_QUADS = Chunk::WIDTH * Chunk::SECTION_HEIGHT * Chunk::DEPTH * 6;
+	constexpr uint32_t MAX_RANGES = Chunk::SECTIONS * ((MAX_SECTION_QUADS + App::QUADS_PER_DRAW - 1) / App::QUADS_PER_DRAW);
+
+	GLint firsts[MAX_RANGES];
+	GLsizei counts[MAX_RANGES];
+	const void* offsets[MAX_RANGES] = {};
+	GLsizei ranges = 0;
+
+	if (batch.pulled) {
+		for (const auto& slot : batch.sections) {
+			if (slot.quads) {
+				firsts[ranges] = static_cast<GLint>(slot.first * 6);
+				counts[ranges++] = static_cast<GLsizei>(slot.quads * 6);
+			}
+		}
+		glMultiDrawArrays(GL_TRIANGLES, firsts, counts, ranges);
+		return;
+	}
+
+	for (const auto& slot : batch.sections) {
+		for (uint32_t first = 0; first < slot.quads; first += App::QUADS_PER_DRAW) {
+			firsts[ranges] = static_cast<GLint>((slot.first + first) * 4);
+			counts[ranges++] = static_cast<GLsizei>(std::min(slot.quads - first, App::QUADS_PER_DRAW) * 6);
+		}
+	}
+	glBindVertexArray(batch.vao);
+	glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts, GL_UNSIGNED_SHORT, offsets, ranges, firsts);
 }
 
-void App::renderChunk(const Chunk& chunk, const WorldUBO& worldUbo, const GLuint ubo, const RenderType type) const
+size_t App::uploadChunk(const ChunkCoord& coord, const StagedMesh& staged, Chunk::ChunkRenderData& data) const
 {
-	glUseProgram(renderer->getShaderProgram());
+	data.origin = glm::vec3(coord.x * Chunk::WIDTH, 0.0f, coord.y * Chunk::DEPTH);
+	return uploadBatch(staged.opaque, staged.opaqueSectionQuads, staged.sections,
+			quadIndexBuffer, quadPulling, data.opaque)
+		+ uploadBatch(staged.transparent, staged.transparentSectionQuads, staged.sections,
+			quadIndexBuffer, quadPulling, data.transparent);
+}
+
+void App::drawBatch(const Chunk::RenderBatch& batch, const glm::vec3& origin) const
+{
+	if (batch.pulled) {
+		glUseProgram(renderer->getQuadShaderProgram());
+		glUniform3fv(CHUNK_ORIGIN_UNIFORM, 1, &origin[0]);
+		glBindVertexArray(emptyVAO);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, QUAD_BUFFER_BINDING, batch.vbo);
+	}
+	else {
+		glUseProgram(renderer->getShaderProgram());
+		glUniform3fv(CHUNK_ORIGIN_UNIFORM, 1, &origin[0]);
+	}
+	drawSections(batch);
+}
+
+void App::integrateMeshes(const double budgetMs)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto deadline = Clock::now() + std::chrono::duration<double, std::milli>(budgetMs);
+
+	uploadStats.bytesThisFrame = 0;
+	uploadStats.uploadsThisFrame = 0;
+	uploadStats.sectionsThisFrame = 0;
+
+	auto& completed = world.getCompletedMeshes();
+	auto& chunks = world.getChunks();
+
+	// chunk_mutex is held only to take the mesh out and to put the batches
+	// back; the GL work in between leaves the workers streaming
+	auto integrate = [&](const MeshUpload& upload) {
+		StagedMesh staged;
+		Chunk::ChunkRenderData mesh;
+		{
+			std::lock_guard lock(world.chunk_mutex);
+			const auto it = chunks.find(upload.coord);
+			if (it == chunks.end() || !it->second.chunk || it->second.chunk->meshVersion != upload.version)
+				return;	// unloaded, or a newer mesh is already queued
+
+			// The GPU owns the mesh now; a mesh installed from here on starts from it
+			Chunk& chunk = *it->second.chunk;
+			staged.opaque.swap(chunk.cachedOpaqueQuads);
+			staged.transparent.swap(chunk.cachedTransparentQuads);
+			staged.opaqueSectionQuads = std::exchange(chunk.opaqueSectionQuads, {});
+			staged.transparentSectionQuads = std::exchange(chunk.transparentSectionQuads, {});
+			staged.sections = std::exchange(chunk.meshedSections, 0);
+			mesh = it->second.mesh;
+			world.updateRecordBytes(it->second);
+		}
+
+		uploadStats.bytesThisFrame += uploadChunk(upload.coord, staged, mesh);
+		++uploadStats.uploadsThisFrame;
+		uploadStats.sectionsThisFrame += std::popcount(staged.sections);
+
+		// Records are only erased on this thread, by unloadChunks and
+		// reprioritisePendingLoads, never during integration: it is still here
+		std::lock_guard lock(world.chunk_mutex);
+		const auto it = chunks.find(upload.coord);
+
+		// A mesh installed during the upload is queued and goes on top of
+		// these batches; the chunk stays Meshed and the edit stays pending for it
+		it->second.mesh = mesh;
+		world.updateRecordBytes(it->second);
+		if (it->second.chunk->meshVersion != upload.version)
+			return;
+
+		if (it->second.state == ChunkState::Meshed)
+			it->second.state = ChunkState::Uploaded;
+		if (it->second.meshedEditAt > 0.0) {
+			editLatency.record(static_cast<float>((glfwGetTime() - it->second.meshedEditAt) * 1000.0));
+			it->second.meshedEditAt = 0.0;
+		}
+	};
+
+	// Each queue makes some progress every frame, then stops once the frame
+	// budget is spent. Edits go first: the player is waiting on them
+	auto drain = [&](MPSCQueue<MeshUpload>& queue) {
+		const size_t before = uploadStats.uploadsThisFrame;
+		MeshUpload upload{};
+		while ((uploadStats.uploadsThisFrame == before || Clock::now() < deadline) && queue.pop(upload))
+			integrate(upload);
+	};
+	drain(world.getCompletedEdits());
+	drain(completed);
+
+	uploadStats.queueDepth = completed.size() + world.getCompletedEdits().size();
+}
 
+void App::renderChunk(const Chunk::ChunkRenderData& mesh, const WorldUBO& worldUbo, const GLuint ubo, const RenderType type) const
+{
 	glBindBufferBase(GL_UNIFORM_BUFFER, 0, ubo);
 	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(WorldUBO), &worldUbo);
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
@@ -279,25 +645,19 @@ void App::renderChunk(const Chunk& chunk, const WorldUBO& worldUbo, const GLuint
 	// ==========================
 	// OPAQUE PASS
 	// ==========================
-	if (type == RenderType::Opaque && chunk.renderData.opaque.indexCount)
+	if (type == RenderType::Opaque && mesh.opaque.quadCount)
 	{
 		glDisable(GL_BLEND);
 		glEnable(GL_DEPTH_TEST);
 		glDepthMask(GL_TRUE);
 
-		glBindVertexArray(chunk.renderData.opaque.vao);
-		glDrawElements(
-			GL_TRIANGLES,
-			chunk.renderData.opaque.indexCount,
-			GL_UNSIGNED_INT,
-			nullptr
-		);
+		drawBatch(mesh.opaque, mesh.origin);
 	}
 
 	// ==========================
 	// TRANSPARENT PASS (WATER)
 	// ==========================
-	if (type == RenderType::Transparent && chunk.renderData.transparent.indexCount)
+	if (type == RenderType::Transparent && mesh.transparent.quadCount)
 	{
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -305,13 +665,7 @@ void App::renderChunk(const Chunk& chunk, const WorldUBO& worldUbo, const GLuint
 		glEnable(GL_DEPTH_TEST);
 		glDepthMask(GL_FALSE);
 
-		glBindVertexArray(chunk.renderData.transparent.vao);
-		glDrawElements(
-			GL_TRIANGLES,
-			chunk.renderData.transparent.indexCount,
-			GL_UNSIGNED_INT,
-			nullptr
-		);
+		drawBatch(mesh.transparent, mesh.origin);
 
 		glDepthMask(GL_TRUE);
 		glDisable(GL_BLEND);
@@ -358,137 +712,335 @@ void App::toggleSpeedBoost()
 	camera->rotSpeed = (camera->rotSpeed == camera->baseRotSpeed) ? camera->baseRotSpeed * 2.0f : camera->baseRotSpeed;
 }
 
-void App::calcChunkAO(const glm::ivec2& coord, Chunk& chunk, const World& world)
+void App::togglePrediction()
 {
-    constexpr int W = Chunk::WIDTH;
-    constexpr int H = Chunk::HEIGHT;
-    constexpr int D = Chunk::DEPTH;
+	world.predictionEnabled = !world.predictionEnabled;
+}
 
-    const auto& chunks = world.getChunks();
+void App::toggleLanePolicy()
+{
+	const bool strict = threadPool->getLanePolicy() == ThreadPool::LanePolicy::Strict;
+	threadPool->setLanePolicy(strict ? ThreadPool::LanePolicy::Weighted : ThreadPool::LanePolicy::Strict);
+}
 
-    // Pre-fetch neighbor chunks
-    const Chunk* neighbors[9] = {nullptr};
-    for (int dz = -1; dz <= 1; ++dz) {
-        for (int dx = -1; dx <= 1; ++dx) {
-            auto it = chunks.find(coord + glm::ivec2(dx, dz));
-            neighbors[(dz + 1) * 3 + (dx + 1)] = (it != chunks.end()) ? &it->second : nullptr;
-        }
-    }
+void EditLatency::record(const float ms)
+{
+	int bucket = 0;
+	while (bucket < BUCKETS - 1 && ms >= static_cast<float>(8 << bucket))
+		++bucket;
+	++counts[bucket];
+	++samples;
+	lastMs = ms;
+	maxMs = std::max(maxMs, ms);
+}
 
-	auto getBlock = [&](int x, int y, int z) -> bool {
-		if (y < 0 || y >= H) return false;
-
-		int cx = x, cz = z;
-		int nidx_x = 1, nidx_z = 1;
-
-		if (x < 0) { nidx_x = 0; cx += W; }
-		else if (x >= W) { nidx_x = 2; cx -= W; }
-
-		if (z < 0) { nidx_z = 0; cz += D; }
-		else if (z >= D) { nidx_z = 2; cz -= D; }
-
-		const Chunk* neighbor = neighbors[nidx_z * 3 + nidx_x];
-		if (!neighbor) return false;
-
-		const Voxel v = neighbor->getVoxel(cx, y, cz);
-		uint8_t bt = getBlockType(v);
-
-		// Only count solid blocks for AO, not water or air
-		return bt != 0 && static_cast<BlockType>(bt) != BlockType::Water;
-    };
-
-    constexpr auto calcAO = [](bool s1, bool s2, bool c) -> uint8_t {
-       int darkness = (s1 ? 1 : 0) + (s2 ? 1 : 0) + (c ? 1 : 0);
-       return std::max(1, 3 - darkness);  // Never go below 1 (never fully dark)
-    };
-
-    const glm::vec3 offset(coord.x * W, 0.0f, coord.y * D);
-    constexpr uint8_t cornerLUT[4] = {0, 1, 3, 2};
-
-    // =====================================================================
-    // Helper lambda to calculate AO for a single vertex
-    // =====================================================================
-    auto calcVertexAO = [&](const Vertex& v, size_t vertexIndex) -> uint8_t {
-        glm::vec3 localPos = v.position - offset;
-        int vx = static_cast<int>(localPos.x);
-        int vy = static_cast<int>(localPos.y);
-        int vz = static_cast<int>(localPos.z);
-
-        uint8_t normalIdx = v.normal;
-        uint8_t corner = cornerLUT[vertexIndex % 4];
-
-        bool cornerX = corner & 1;
-        bool cornerY = corner & 2;
-
-        uint8_t ao = 3;
-
-        if (normalIdx < 2) { // X faces (perpendicular to X axis)
-            int axq = vx + (normalIdx == 0 ? 1 : 0);
-            int py = cornerY ? vy + 1 : vy - 1;
-            int pz = cornerX ? vz + 1 : vz - 1;
-
-            ao = calcAO(
-                getBlock(axq, py, vz),
-                getBlock(axq, vy, pz),
-                getBlock(axq, py, pz)
-            );
-        }
-        else if (normalIdx < 4) { // Y faces (perpendicular to Y axis)
-            int ayq = vy + (normalIdx == 2 ? 1 : 0);
-            int px = cornerX ? vx + 1 : vx - 1;
-            int pz = cornerY ? vz + 1 : vz - 1;  // FIXED: was cornerX, should be cornerY
-
-            ao = calcAO(
-                getBlock(px, ayq, vz),
-                getBlock(vx, ayq, pz),
-                getBlock(px, ayq, pz)
-            );
-        }
-        else { // Z faces (perpendicular to Z axis)
-            int azq = vz + (normalIdx == 4 ? 1 : 0);
-            int px = cornerX ? vx + 1 : vx - 1;
-            int py = cornerY ? vy + 1 : vy - 1;
-
-            ao = calcAO(
-                getBlock(px, vy, azq),
-                getBlock(vx, py, azq),
-                getBlock(px, py, azq)
-            );
-        }
-
-        return ao;
-    };
-
-    // =====================================================================
-    // Calculate AO for opaque blocks
-    // =====================================================================
-    for (size_t i = 0; i < chunk.cachedOpaqueVertices.size(); ++i) {
-        auto& v = chunk.cachedOpaqueVertices[i];
-        v.ao = calcVertexAO(v, i);
-    }
+void App::startFlythrough()
+{
+	if (!camera || flythrough.active) return;
+
+	flythrough = {};
+	flythrough.active = true;
+	flythrough.restorePrediction = world.predictionEnabled;
+	flythrough.restorePos = camera->pos;
+	world.predictionEnabled = false;
+	camera->pos = {0.0f, 160.0f, FLYTHROUGH_RUN_SPACING};
+}
+
+void App::updateFlythrough(const float dt)
+{
+	flythrough.elapsed += dt;
+
+	// Fly along +X, level
+	camera->yaw = 0.0f;
+	camera->pitch = 0.0f;
+	camera->dir = {1.0f, 0.0f, 0.0f};
+
+	if (flythrough.settling) {
+		const auto streaming = world.getStreamingStats();
+		const bool idle = streaming.pendingLoads == 0 && world.getCompletedMeshes().size() == 0;
+		if (idle || flythrough.elapsed > FLYTHROUGH_SETTLE_TIMEOUT) {
+			flythrough.settling = false;
+			flythrough.elapsed = 0.0f;
+			flythrough.holes = 0;
+		}
+		return;
+	}
+
+	camera->pos += camera->dir * camera->baseMoveSpeed * 10.0f * dt;
+	if (flythrough.elapsed < FLYTHROUGH_SECONDS)
+		return;
+
+	flythrough.holesPerSecond[flythrough.run] = static_cast<float>(flythrough.holes) / flythrough.elapsed;
+
+	if (flythrough.run == 0) {
+		// Second run over equally fresh terrain
+		flythrough.run = 1;
+		flythrough.settling = true;
+		flythrough.elapsed = 0.0f;
+		world.predictionEnabled = true;
+		camera->pos = {0.0f, 160.0f, FLYTHROUGH_RUN_SPACING * 2.0f};
+		return;
+	}
+
+	flythrough.active = false;
+	world.predictionEnabled = flythrough.restorePrediction;
+	camera->pos = flythrough.restorePos;
+}
+
+void App::benchmarkVoxelQueries()
+{
+	using Clock = std::chrono::steady_clock;
+	constexpr int QUERIES = 1 << 20;
+
+	// Same pseudo-random positions for both paths, spread over the 3x3
+	// block around the player
+	const glm::ivec3 origin = glm::floor(camera->pos);
+	const glm::ivec3 blockMin(floorDiv(origin.x, Chunk::WIDTH) * Chunk::WIDTH - Chunk::WIDTH, 0,
+		floorDiv(origin.z, Chunk::DEPTH) * Chunk::DEPTH - Chunk::DEPTH);
+	std::vector<glm::ivec3> positions(QUERIES);
+	uint32_t seed = 0x9E3779B9u;
+	for (auto& p : positions) {
+		seed = seed * 1664525u + 1013904223u;
+		p = blockMin + glm::ivec3(static_cast<int>(seed % (Chunk::WIDTH * 3)),
+			static_cast<int>((seed >> 8) % Chunk::HEIGHT),
+			static_cast<int>((seed >> 16) % (Chunk::DEPTH * 3)));
+	}
+
+	// Before: lock, floorDiv, modulo and map lookup per query
+	uint32_t checksum = 0;
+	auto start = Clock::now();
+	for (const auto& p : positions) {
+		std::lock_guard lock(world.chunk_mutex);
+		const Chunk* chunk = world.findChunk({floorDiv(p.x, Chunk::WIDTH), floorDiv(p.z, Chunk::DEPTH)});
+		if (chunk)
+			checksum += chunk->getVoxel(((p.x % Chunk::WIDTH) + Chunk::WIDTH) % Chunk::WIDTH, p.y,
+				((p.z % Chunk::DEPTH) + Chunk::DEPTH) % Chunk::DEPTH);
+	}
+	const std::chrono::duration<double> before = Clock::now() - start;
+
+	// After: one lock and one neighborhood
+	uint32_t checksumAfter = 0;
+	start = Clock::now();
+	{
+		std::lock_guard lock(world.chunk_mutex);
+		const ChunkNeighborhood neighborhood(world, origin);
+		for (const auto& p : positions)
+			checksumAfter += neighborhood.voxelAt(p);
+	}
+	const std::chrono::duration<double> after = Clock::now() - start;
+
+	queryBenchmark.beforeQps = static_cast<float>(QUERIES / before.count());
+	queryBenchmark.afterQps = static_cast<float>(QUERIES / after.count());
+	queryBenchmark.mismatch = checksum != checksumAfter;
+}
+
+void App::toggleMesher()
+{
+	const bool binary = world.mesher == Mesher::Binary;
+	world.mesher = binary ? Mesher::Scalar : Mesher::Binary;
+}
+
+void App::toggleQuadPulling()
+{
+	quadPulling = !quadPulling;
 
-	chunk.aoCalculated = true;
+	// Uploaded meshes no longer have their quads on the CPU
+	world.remeshAll(*threadPool);
 }
 
-void App::queueVisibleChunksAO(World& world, const std::vector<std::pair<glm::ivec2, Chunk*>>& chunksToCalcAO, ThreadPool& threadPool)
+void App::benchmarkMeshers()
 {
-	for (const auto& coord : chunksToCalcAO | std::views::keys) {
-		threadPool.enqueue([coord, &world]() {
+	using Clock = std::chrono::steady_clock;
+	constexpr size_t SAMPLES = 64;
+	constexpr int REPEATS = 4;
+	constexpr Mesher KINDS[2] = {Mesher::Scalar, Mesher::Binary};
+
+	// Meshed chunks have all four neighbours, so both paths see real borders
+	std::vector<ChunkCoord> loaded;
+	{
+		std::lock_guard lock(world.chunk_mutex);
+		for (const auto& [coord, record] : world.getChunks()) {
+			if (loaded.size() == SAMPLES)
+				break;
+			if (record.chunk && (record.state == ChunkState::Meshed || record.state == ChunkState::Uploaded))
+				loaded.push_back(coord);
+		}
+	}
+	if (loaded.empty())
+		return;
+
+	// One sample at a time in scratch, as a mesh job sees it: loaded chunks
+	// are copied out under chunk_mutex, and their borders come from the live
+	// neighbours. Synthetic chunks sit far from anything loaded, so their
+	// borders read as air. Ocean: a shallow band under sea level; mountain:
+	// ridges up to ~y 200
+	ScratchArena::Scope scope;
+	Voxel* voxels = ScratchArena::local().allocate<Voxel>(Chunk::SIZE);
+	const ChunkCoord far(1 << 20, 1 << 20);
+	auto voxel = [](const BlockType type) { return packVoxelData(true, 255, 255, 255, static_cast<uint8_t>(type)); };
+	auto at = [&](const int x, const int y, const int z) -> Voxel& {
+		return voxels[x + y * Chunk::WIDTH + z * Chunk::WIDTH * Chunk::HEIGHT];
+	};
+
+	auto fill = [&](const int set, const size_t n, ChunkCoord& coord) {
+		if (set == MesherBenchmark::Loaded) {
 			std::lock_guard lock(world.chunk_mutex);
-			if (const auto it = world.getChunks().find(coord); it != world.getChunks().end())
-				calcChunkAO(coord, it->second, world);
-		});
+			const Chunk* chunk = world.findChunk(loaded[n]);
+			if (!chunk)
+				return false;	// unloaded since
+			std::ranges::copy(chunk->getVoxels(), voxels);
+			coord = loaded[n];
+			return true;
+		}
+
+		std::fill_n(voxels, Chunk::SIZE, Voxel{0});
+		for (int x = 0; x < Chunk::WIDTH; ++x) {
+			for (int z = 0; z < Chunk::DEPTH; ++z) {
+				if (set == MesherBenchmark::Ocean) {
+					for (int y = 0; y < 64; ++y)
+						at(x, y, z) = voxel(y < 40 ? BlockType::Stone : y < 44 ? BlockType::Sand : BlockType::Water);
+					continue;
+				}
+				const float wx = static_cast<float>(n * Chunk::WIDTH + x);
+				const int peak = 130 + static_cast<int>(50.0f * std::sin(wx * 0.11f) * std::cos(z * 0.23f + static_cast<float>(n))
+					+ 20.0f * std::sin(wx * 0.37f + z * 0.19f));
+				for (int y = 0; y <= peak; ++y)
+					at(x, y, z) = voxel(y < peak - 2 ? BlockType::Stone : peak > 160 ? BlockType::Snow : BlockType::Grass);
+			}
+		}
+		coord = far;
+		return true;
+	};
+
+	// Exactly sized copies, like a mesh job's output, kept to compare the meshers
+	using Mesh = std::pair<std::vector<ChunkQuad>, std::vector<ChunkQuad>>;
+	auto mesh = [&](const ChunkCoord& coord, const Mesher kind) {
+		ScratchArena::Scope inner;
+		ScratchVector<ChunkQuad> opaque(World::MESH_SCRATCH_QUADS);
+		ScratchVector<ChunkQuad> transparent(World::MESH_SCRATCH_QUADS);
+		std::array<uint32_t, Chunk::SECTIONS> opaqueCounts{};
+		std::array<uint32_t, Chunk::SECTIONS> transparentCounts{};
+		world.buildGreedyMesh(std::span<const Voxel, Chunk::SIZE>(voxels, Chunk::SIZE), coord, kind,
+			Chunk::ALL_SECTIONS, {opaque, opaqueCounts}, {transparent, transparentCounts});
+		return Mesh(std::vector<ChunkQuad>(opaque.begin(), opaque.end()),
+			std::vector<ChunkQuad>(transparent.begin(), transparent.end()));
+	};
+
+	auto sameMesh = [](const Mesh& a, const Mesh& b) {
+		auto same = [](const auto& x, const auto& y) {
+			return x.size() == y.size() && std::memcmp(x.data(), y.data(), x.size() * sizeof(x[0])) == 0;
+		};
+		return same(a.first, b.first) && same(a.second, b.second);
+	};
+
+	mesherBenchmark.chunks = loaded.size();
+	mesherBenchmark.mismatches = 0;
+	for (int set = 0; set < MesherBenchmark::SET_COUNT; ++set) {
+		std::chrono::duration<double> elapsed[2] = {};
+		size_t meshed = 0;
+		for (size_t n = 0; n < SAMPLES; ++n) {
+			ChunkCoord coord;
+			if ((set == MesherBenchmark::Loaded && n >= loaded.size()) || !fill(set, n, coord))
+				continue;
+
+			Mesh results[2];
+			for (int k = 0; k < 2; ++k) {
+				const auto start = Clock::now();
+				for (int r = 0; r < REPEATS; ++r)
+					results[k] = mesh(coord, KINDS[k]);
+				elapsed[k] += Clock::now() - start;
+			}
+			mesherBenchmark.mismatches += !sameMesh(results[0], results[1]);
+			++meshed;
+		}
+
+		for (int k = 0; k < 2; ++k)
+			mesherBenchmark.chunksPerSecond[set][k] = meshed ? static_cast<float>(meshed * REPEATS / elapsed[k].count()) : 0.0f;
 	}
 }
 
+void App::benchmarkThreadPool()
+{
+	using Clock = std::chrono::steady_clock;
+	constexpr int ROOTS = 512;
+	constexpr int CHILDREN = 64;	// spawned from the worker, like mesh jobs after a load
+	constexpr size_t THREADS[] = {1, 2, 4, 8};
+	constexpr ThreadPool::Mode MODES[] = {ThreadPool::Mode::SharedQueue, ThreadPool::Mode::WorkStealing};
+
+	// A few hundred nanoseconds of work, so scheduling cost is visible
+	static constexpr auto work = [](std::atomic<uint32_t>& sink) {
+		uint32_t h = sink.load(std::memory_order_relaxed);
+		for (int i = 0; i < 256; ++i)
+			h = h * 1664525u + 1013904223u;
+		sink.fetch_add(h, std::memory_order_relaxed);
+	};
+
+	for (size_t m = 0; m < std::size(MODES); ++m) {
+		for (size_t t = 0; t < std::size(THREADS); ++t) {
+			std::atomic<uint32_t> sink{0};
+			ThreadPool pool(THREADS[t], MODES[m]);
+
+			const auto start = Clock::now();
+			pool.submitBatch(ROOTS, [&pool, &sink](size_t) {
+				return [&pool, &sink] {
+					for (int c = 0; c < CHILDREN; ++c)
+						pool.submit([&sink] { work(sink); });
+					work(sink);
+				};
+			});
+			pool.wait();
+			const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+			poolBenchmark.tasksPerSecond[m][t] = static_cast<float>(ROOTS * (CHILDREN + 1) / elapsed.count());
+		}
+	}
+}
+
+size_t App::countVisibleHoles()
+{
+	const ChunkCoord center(
+		floorDiv(static_cast<int>(camera->pos.x), Chunk::WIDTH),
+		floorDiv(static_cast<int>(camera->pos.z), Chunk::DEPTH));
+
+	size_t holes = 0;
+	std::lock_guard lock(world.chunk_mutex);
+	const auto& chunks = world.getChunks();
+	forEachRingDelta(std::nullopt, center, world.getChunkRadius(), [&](const ChunkCoord c) {
+		const glm::vec3 min(c.x * Chunk::WIDTH, 0.0f, c.y * Chunk::DEPTH);
+		if (!world.isBoxInFrustum(min, min + glm::vec3(Chunk::WIDTH, Chunk::HEIGHT, Chunk::DEPTH)))
+			return;
+
+		const auto it = chunks.find(c);
+		if (it == chunks.end() || (!it->second.mesh.opaque.vbo && !it->second.mesh.transparent.vbo))
+			++holes;
+	});
+	return holes;
+}
+
+void App::setupQuadIndices()
+{
+	std::vector<uint16_t> indices;
+	indices.reserve(QUADS_PER_DRAW * 6);
+	for (uint32_t quad = 0; quad < QUADS_PER_DRAW; ++quad) {
+		const auto base = static_cast<uint16_t>(quad * 4);
+		indices.insert(indices.end(), {base, uint16_t(base + 1), uint16_t(base + 2), base, uint16_t(base + 2), uint16_t(base + 3)});
+	}
+
+	glCreateBuffers(1, &quadIndexBuffer);
+	glNamedBufferData(quadIndexBuffer, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+}
+
 void App::setupHighlightCube()
 {
-	// 1x1x1 cube
-	static constexpr float vertices[] = {
+	// 1x1x1 cube, facing +Y with no light so the lines draw dark
+	static constexpr auto corner = [](const int x, const int y, const int z) {
+		return ChunkVertex::pack(x, y, z, 0, 0, 2, 0, 0);
+	};
+	static constexpr ChunkVertex vertices[] = {
 		// bottom
-		0,0,0,  1,0,0,  1,0,1,  0,0,1,
+		corner(0,0,0),  corner(1,0,0),  corner(1,0,1),  corner(0,0,1),
 		// top
-		0,1,0,  1,1,0,  1,1,1,  0,1,1
+		corner(0,1,0),  corner(1,1,0),  corner(1,1,1),  corner(0,1,1)
 	};
 
 	static constexpr uint32_t indices[] = {
@@ -512,31 +1064,13 @@ void App::setupHighlightCube()
 	glBindBuffer(GL_ARRAY_BUFFER, highlightedBlock.highlightVBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+	glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(ChunkVertex), nullptr);
 	glEnableVertexAttribArray(0);
 
 	// Index buffer
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, highlightedBlock.highlightIBO);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
-	// ===== CONSTANT ATTRIBUTES (IMPORTANT PART) =====
-
-	// UV (location = 1)
-	glDisableVertexAttribArray(1);
-	glVertexAttrib2f(1, 0.0f, 0.0f);
-
-	// Texture index (location = 2)
-	glDisableVertexAttribArray(2);
-	glVertexAttribI1ui(2, 0); // MUST be a valid opaque texture layer
-
-	// Normal (location = 3) → +Y
-	glDisableVertexAttribArray(3);
-	glVertexAttribI1ui(3, 2); // normals[2] = (0,1,0)
-
-	// AO (location = 4) → max
-	glDisableVertexAttribArray(4);
-	glVertexAttribI1ui(4, 0);
-
 	glBindVertexArray(0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -587,6 +1121,7 @@ void App::renderBlockHighlight()
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
 	glBindTextureUnit(0, renderer->getTextureArray());
+	glUniform3f(CHUNK_ORIGIN_UNIFORM, 0.0f, 0.0f, 0.0f);	// the model matrix places it
 
 	glBindVertexArray(highlightedBlock.highlightVAO);
 
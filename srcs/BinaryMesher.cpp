@@ -0,0 +1,297 @@
+#include "World.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+/* ===================== Binary Greedy Meshing ===================== */
+// Same faces, same merge order as runGreedyPass, without the per-cell
+// branching: every column along an axis is a bitmask, a face is a set bit
+// whose neighbour bit is clear (`self & ~(next >> 1)`), and merging walks
+// per-type row masks with countr_zero / countr_one.
+
+namespace {
+
+static_assert(static_cast<int>(BlockType::Amethyst) < World::MESHER_BLOCK_TYPES);
+
+constexpr int W = Chunk::WIDTH;
+constexpr int H = Chunk::HEIGHT;
+constexpr int D = Chunk::DEPTH;
+
+// Slices are at most 256 rows of 16 bits or 16 rows of 256 bits, so one
+// layer-major buffer of this many words holds every slice of an axis
+constexpr int SLICE_WORDS = 4096;
+
+struct BinaryScratch {
+    // Per type: face bits, [layer][row][word]. Merging clears every bit it
+    // covers, so once zeroed the buffers are back to zero after each axis
+    uint64_t types[World::MESHER_BLOCK_TYPES][SLICE_WORDS];
+    uint64_t visible[2][SLICE_WORDS];       // opaque, transparent
+
+    // Occupancy columns, one padding cell at each end: [row][column][word]
+    uint64_t opaque[SLICE_WORDS];
+    uint64_t solid[SLICE_WORDS];
+};
+
+template<int WORDS>
+int firstSet(const uint64_t* row)
+{
+    for (int k = 0; k < WORDS; ++k)
+        if (row[k])
+            return k * 64 + std::countr_zero(row[k]);
+    return -1;
+}
+
+// Set bits in a row from bit i on
+template<int WORDS>
+int runFrom(const uint64_t* row, const int i)
+{
+    int w = 0;
+    for (int k = i >> 6, b = i & 63; k < WORDS; ++k, b = 0) {
+        const int ones = std::countr_one(row[k] >> b);
+        w += ones;
+        if (ones < 64 - b)
+            break;
+    }
+    return w;
+}
+
+// Calls f(word, mask) for the words covering bits [i, i + w)
+template<typename F>
+void forRunWords(const int i, const int w, F&& f)
+{
+    for (int lo = i, end = i + w; lo < end;) {
+        const int k = lo >> 6;
+        const int hi = std::min(end, (k + 1) * 64);
+        const int n = hi - lo;
+        f(k, (n == 64 ? ~uint64_t{0} : (uint64_t{1} << n) - 1) << (lo & 63));
+        lo = hi;
+    }
+}
+
+template<int WORDS>
+bool coversRun(const uint64_t* row, const int i, const int w)
+{
+    bool all = true;
+    forRunWords(i, w, [&](const int k, const uint64_t mask) { all = all && (row[k] & mask) == mask; });
+    return all;
+}
+
+template<int WORDS>
+void clearRun(uint64_t* row, const int i, const int w)
+{
+    forRunWords(i, w, [&](const int k, const uint64_t mask) { row[k] &= ~mask; });
+}
+
+// Faces of `self` toward dir: neighbour of bit k is bit k + dir
+template<int WORDS>
+void columnFaces(const uint64_t* self, const uint64_t* neighbour, const int dir, uint64_t* out)
+{
+    for (int k = 0; k < WORDS; ++k) {
+        const uint64_t next = dir > 0
+            ? (neighbour[k] >> 1) | (k + 1 < WORDS ? neighbour[k + 1] << 63 : 0)
+            : (neighbour[k] << 1) | (k > 0 ? neighbour[k - 1] >> 63 : 0);
+        out[k] = self[k] & ~next;
+    }
+}
+
+// Cells [lo, hi) of dimension `dim` that can hold blocks: all of X and Z,
+// the occupied band of Y
+struct Span {
+    int lo;
+    int hi;
+};
+
+constexpr Span bandOf(const int dim, const int size, const int yMin, const int yMax)
+{
+    return dim == 1 ? Span{yMin, yMax + 1} : Span{0, size};
+}
+
+// First cell past the section of `cell` along dim; only Y is split
+constexpr int sectionEnd(const int dim, const int cell)
+{
+    return dim == 1 ? (cell / Chunk::SECTION_HEIGHT + 1) * Chunk::SECTION_HEIGHT : std::numeric_limits<int>::max();
+}
+
+} // namespace
+
+// A = cells along the axis, U x V = slice, U along the row bits
+template<int AXIS, int A, int U, int V>
+static void meshAxis(
+    BinaryScratch& s,
+    const RenderType renderType[W + 2][H + 2][D + 2],
+    const uint8_t blockTypes[W + 2][H + 2][D + 2],
+    const std::array<uint32_t, 256>& textureIndices,
+    const MeshTarget targets[2],
+    const int yMin, const int yMax)
+{
+    constexpr int COL_WORDS = (A + 2 + 63) / 64;
+    constexpr int ROW_WORDS = (U + 63) / 64;
+    constexpr int u = (AXIS + 1) % 3;
+    constexpr int v = (AXIS + 2) % 3;
+
+    const Span layers = bandOf(AXIS, A, yMin, yMax);
+    const Span rows = bandOf(v, V, yMin, yMax);
+    const Span cols = bandOf(u, U, yMin, yMax);
+
+    auto typeAt = [&](const int layer, const int i, const int j) {
+        int p[3];
+        p[AXIS] = layer;
+        p[u] = i;
+        p[v] = j;
+        return blockTypes[p[0] + 1][p[1] + 1][p[2] + 1];
+    };
+
+    // Only band cells have faces; the padding cells either side of it belong
+    // to the neighbours or to sections not being meshed
+    uint64_t band[COL_WORDS] = {};
+    forRunWords(layers.lo + 1, layers.hi - layers.lo, [&](const int k, const uint64_t mask) { band[k] = mask; });
+
+    for (int dir = -1; dir <= 1; dir += 2) {
+        // Faces out of every column, scattered into the slices they belong to
+        for (int j = rows.lo; j < rows.hi; ++j) {
+            for (int i = cols.lo; i < cols.hi; ++i) {
+                const uint64_t* opaque = &s.opaque[(j * U + i) * COL_WORDS];
+                const uint64_t* solid = &s.solid[(j * U + i) * COL_WORDS];
+
+                uint64_t water[COL_WORDS];
+                for (int k = 0; k < COL_WORDS; ++k)
+                    water[k] = solid[k] & ~opaque[k];
+
+                // Opaque faces show against anything not opaque, water only against air
+                uint64_t faces[2][COL_WORDS];
+                columnFaces<COL_WORDS>(opaque, opaque, dir, faces[0]);
+                columnFaces<COL_WORDS>(water, solid, dir, faces[1]);
+
+                for (int t = 0; t < 2; ++t) {
+                    for (int k = 0; k < COL_WORDS; ++k) {
+                        for (uint64_t bits = faces[t][k] & band[k]; bits; bits &= bits - 1) {
+                            const int layer = k * 64 + std::countr_zero(bits) - 1;
+                            const int word = (layer * V + j) * ROW_WORDS + (i >> 6);
+                            const uint64_t bit = uint64_t{1} << (i & 63);
+                            s.types[typeAt(layer, i, j)][word] |= bit;
+                            s.visible[t][word] |= bit;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Greedy merge, slice by slice in runGreedyPass' order
+        for (int layer = layers.lo; layer < layers.hi; ++layer) {
+            for (int t = 0; t < 2; ++t) {
+                for (int j = rows.lo; j < rows.hi; ++j) {
+                    uint64_t* row = &s.visible[t][(layer * V + j) * ROW_WORDS];
+
+                    for (int i; (i = firstSet<ROW_WORDS>(row)) >= 0;) {
+                        const uint8_t bt = typeAt(layer, i, j);
+                        uint64_t* typeRows = &s.types[bt][layer * V * ROW_WORDS];
+
+                        // Opaque faces only merge with faces shaded the same way
+                        auto aoAt = [&](const int fi, const int fj) {
+                            if (t)
+                                return ChunkQuad::AO_LIT;
+                            int cell[3];
+                            cell[AXIS] = layer;
+                            cell[u] = fi;
+                            cell[v] = fj;
+                            return World::faceAO(renderType, AXIS, dir, cell);
+                        };
+                        const uint8_t ao = aoAt(i, j);
+
+                        // Quads stop at section boundaries, so each belongs to one section
+                        int w = std::min(runFrom<ROW_WORDS>(&typeRows[j * ROW_WORDS], i), sectionEnd(u, i) - i);
+                        for (int r = 1; r < w && !t; ++r)
+                            if (aoAt(i + r, j) != ao)
+                                w = r;
+
+                        auto rowMatches = [&](const int fj) {
+                            if (!coversRun<ROW_WORDS>(&typeRows[fj * ROW_WORDS], i, w))
+                                return false;
+                            for (int r = 0; r < w && !t; ++r)
+                                if (aoAt(i + r, fj) != ao)
+                                    return false;
+                            return true;
+                        };
+                        int h = 1;
+                        const int maxRow = std::min(rows.hi, sectionEnd(v, j));
+                        while (j + h < maxRow && rowMatches(j + h))
+                            ++h;
+
+                        for (int r = 0; r < h; ++r) {
+                            clearRun<ROW_WORDS>(&typeRows[(j + r) * ROW_WORDS], i, w);
+                            clearRun<ROW_WORDS>(&s.visible[t][(layer * V + j + r) * ROW_WORDS], i, w);
+                        }
+
+                        int pos[3];
+                        pos[AXIS] = layer;
+                        pos[u] = i;
+                        pos[v] = j;
+                        World::emitGreedyQuad(targets[t], AXIS, dir, pos, w, h, textureIndices[bt], ao);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Occupancy columns along AXIS for every (i, j) of its slices in the band,
+// padded cells included. Columns outside it stay empty
+template<int AXIS, int A, int U, int V>
+static void fillColumns(BinaryScratch& s, const RenderType renderType[W + 2][H + 2][D + 2],
+    const int yMin, const int yMax)
+{
+    constexpr int COL_WORDS = (A + 2 + 63) / 64;
+    constexpr int u = (AXIS + 1) % 3;
+    constexpr int v = (AXIS + 2) % 3;
+
+    // Along the column the padding cells either side of the band still count
+    const Span layers = bandOf(AXIS, A, yMin, yMax);
+    const Span rows = bandOf(v, V, yMin, yMax);
+    const Span cols = bandOf(u, U, yMin, yMax);
+
+    std::fill_n(s.opaque, U * V * COL_WORDS, 0);
+    std::fill_n(s.solid, U * V * COL_WORDS, 0);
+
+    for (int j = rows.lo; j < rows.hi; ++j) {
+        for (int i = cols.lo; i < cols.hi; ++i) {
+            uint64_t* opaque = &s.opaque[(j * U + i) * COL_WORDS];
+            uint64_t* solid = &s.solid[(j * U + i) * COL_WORDS];
+
+            int p[3];
+            p[u] = i + 1;
+            p[v] = j + 1;
+            for (int c = layers.lo; c < layers.hi + 2; ++c) {
+                p[AXIS] = c;
+                const RenderType rt = renderType[p[0]][p[1]][p[2]];
+                opaque[c >> 6] |= static_cast<uint64_t>(rt == RenderType::Opaque) << (c & 63);
+                solid[c >> 6] |= static_cast<uint64_t>(rt != RenderType::Air) << (c & 63);
+            }
+        }
+    }
+}
+
+void World::runBinaryPasses(
+    const RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
+    const uint8_t blockTypes[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
+    const MeshTarget opaque,
+    const MeshTarget transparent,
+    const int yMin, const int yMax,
+    const int typeCount
+) const
+{
+    // Released with the caller's scope; one opened here would be rewound
+    // under the targets as they grow
+    BinaryScratch* scratch = ScratchArena::local().allocate<BinaryScratch>();
+    std::fill_n(&scratch->types[0][0], typeCount * SLICE_WORDS, 0);
+    std::fill_n(&scratch->visible[0][0], 2 * SLICE_WORDS, 0);
+    const MeshTarget targets[2] = {opaque, transparent};
+
+    // Axis order and slice layout match runGreedyPass: u = axis + 1, v = axis + 2
+    fillColumns<0, W, H, D>(*scratch, renderType, yMin, yMax);
+    meshAxis<0, W, H, D>(*scratch, renderType, blockTypes, textureIndices, targets, yMin, yMax);
+    fillColumns<1, H, D, W>(*scratch, renderType, yMin, yMax);
+    meshAxis<1, H, D, W>(*scratch, renderType, blockTypes, textureIndices, targets, yMin, yMax);
+    fillColumns<2, D, W, H>(*scratch, renderType, yMin, yMax);
+    meshAxis<2, D, W, H>(*scratch, renderType, blockTypes, textureIndices, targets, yMin, yMax);
+}
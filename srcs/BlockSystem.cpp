@@ -1,4 +1,5 @@
 #include "BlockSystem.hpp"
+#include "ChunkNeighborhood.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -39,15 +40,14 @@ Voxel BlockSystem::getVoxelFromWorld(const glm::ivec3& worldPos, World& world)
 
     std::lock_guard lock(world.chunk_mutex);
 
-    const auto& chunks = world.getChunks();
-    const auto it = chunks.find(key);
-    if (it == chunks.end())
+    const Chunk* chunk = world.findChunk(key);
+    if (!chunk)
         return 0;
 
     const int localX = ((worldPos.x % Chunk::WIDTH) + Chunk::WIDTH) % Chunk::WIDTH;
     const int localZ = ((worldPos.z % Chunk::DEPTH) + Chunk::DEPTH) % Chunk::DEPTH;
 
-    return it->second.getVoxel(localX, worldPos.y, localZ);
+    return chunk->getVoxel(localX, worldPos.y, localZ);
 }
 
 void BlockSystem::setVoxelInWorld(const glm::ivec3& worldPos, const Voxel voxel, World& world)
@@ -61,20 +61,23 @@ void BlockSystem::setVoxelInWorld(const glm::ivec3& worldPos, const Voxel voxel,
 
     std::lock_guard lock(world.chunk_mutex);
 
-    auto& chunks = world.getChunks();
-    const auto it = chunks.find(key);
-    if (it == chunks.end())
+    Chunk* chunk = world.findChunk(key);
+    if (!chunk)
         return;
 
-    it->second.setVoxel(localX, ((worldPos.y % Chunk::HEIGHT) + Chunk::HEIGHT) % Chunk::HEIGHT, localZ, voxel);
-    it->second.aoCalculated = false;
+    const int y = ((worldPos.y % Chunk::HEIGHT) + Chunk::HEIGHT) % Chunk::HEIGHT;
+    chunk->setVoxel(localX, y, localZ, voxel);
+    chunk->edited = true;
+
+    // Faces and AO up to one block away can change, so only the sections
+    // holding layers y-1..y+1 are remeshed, here and across a border
+    const Chunk::SectionMask sections = Chunk::sectionsOf(y - 1, y + 1);
+    world.markChunkDirty(key, sections);
 
     // Mark adjacent chunks dirty if boundary block
-    auto markDirty = [&chunks](const ChunkCoord& coord) {
-        if (const auto iter = chunks.find(coord); iter != chunks.end()) {
-            iter->second.markMeshDirty();
-            iter->second.aoCalculated = false;
-        }
+    auto markDirty = [&world, sections](const ChunkCoord& coord) {
+        if (world.findChunk(coord))
+            world.markChunkDirty(coord, sections);
     };
 
     if (localX == 0) markDirty(ChunkCoord(chunkX - 1, chunkZ));
@@ -117,11 +120,15 @@ RaycastHit BlockSystem::raycastBlocks(const glm::vec3& rayOrigin, const glm::vec
     const glm::vec3 rayDir = glm::normalize(rayDirection);
     constexpr float stepSize = 0.05f;
 
+    // Reach is well under a chunk, so the 3x3 around the origin covers the ray
+    std::lock_guard lock(world.chunk_mutex);
+    const ChunkNeighborhood neighborhood(world, glm::ivec3(glm::floor(rayOrigin)));
+
     for (float distance = 0.0f; distance <= maxReachDistance; distance += stepSize) {
         const glm::vec3 rayPos = rayOrigin + rayDir * distance;
         const auto blockPos = glm::ivec3(glm::floor(rayPos));
 
-        if (getVoxelFromWorld(blockPos, world) != 0) {
+        if (neighborhood.voxelAt(blockPos) != 0) {
             hit.blockPos = blockPos;
             hit.distance = distance;
             hit.face = detectFace(blockPos, rayPos);
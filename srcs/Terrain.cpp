@@ -1,8 +1,8 @@
 #include "Terrain.hpp"
+#include "ScratchArena.hpp"
 #include "stb_perlin.h"
 #include <glm/glm.hpp>
 #include <algorithm>
-#include <mutex>
 
 static constexpr uint32_t STONE = packVoxelData(1, 255, 255, 255, (uint8_t)BlockType::Stone);
 static constexpr uint32_t DIRT = packVoxelData(1, 255, 255, 255, (uint8_t)BlockType::Dirt);
@@ -142,51 +142,29 @@ BlockType TerrainGenerator::determineBiome(float temperature, float humidity, fl
 void TerrainGenerator::generateChunk(Chunk& chunk, const glm::ivec2& coord) {
     const int baseWX = coord.x * Chunk::WIDTH;
     const int baseWZ = coord.y * Chunk::DEPTH;
-    const uint64_t coordHash = hashCoord(coord);
-
-    // Lock cache access
-    std::lock_guard lock(noiseCacheMutex);
-
-    // Check if noise is already cached
-    if (!noiseCache.contains(coordHash)) {
-        // Generate and cache noise maps
-        std::vector<float> terrainNoise(Chunk::WIDTH * Chunk::DEPTH);
-        std::vector<float> temperatureNoise(Chunk::WIDTH * Chunk::DEPTH);
-        std::vector<float> humidityNoise(Chunk::WIDTH * Chunk::DEPTH);
-        std::vector<float> mountain(Chunk::WIDTH * Chunk::DEPTH);
-
-        // Precompute all 2D noise maps for this chunk
-        for (int x = 0; x < Chunk::WIDTH; ++x) {
-            for (int z = 0; z < Chunk::DEPTH; ++z) {
-                int wx = baseWX + x;
-                int wz = baseWZ + z;
-                int idx = x * Chunk::DEPTH + z;
-
-                // Sample all noise types
-                float terrain = sampleTerrainNoise(wx, wz);
-                float continental = sampleContinentalNoise(wx, wz);
-                float erosion = sampleErosionNoise(wx, wz);
-                float temp = sampleTemperatureNoise(wx, wz);
-                float humid = sampleHumidityNoise(wx, wz);
-
-                // Store computed values
-                terrainNoise[idx] = calculateHeight(terrain, continental, erosion);
-                temperatureNoise[idx] = temp;
-                humidityNoise[idx] = humid;
-                mountain[idx] = continental;
-            }
-        }
 
-        noiseCache[coordHash] = {std::move(terrainNoise), std::move(temperatureNoise),
-                                 std::move(humidityNoise), std::move(mountain)};
-    }
+    // Per-column 2D noise, in this worker's scratch
+    ScratchArena::Scope scope;
+    constexpr int COLUMNS = Chunk::WIDTH * Chunk::DEPTH;
+    auto& arena = ScratchArena::local();
+    float* terrain = arena.allocate<float>(COLUMNS);
+    float* temperature = arena.allocate<float>(COLUMNS);
+    float* humidity = arena.allocate<float>(COLUMNS);
+    float* mountain = arena.allocate<float>(COLUMNS);
+
+    for (int x = 0; x < Chunk::WIDTH; ++x) {
+        for (int z = 0; z < Chunk::DEPTH; ++z) {
+            const int wx = baseWX + x;
+            const int wz = baseWZ + z;
+            const int idx = x * Chunk::DEPTH + z;
 
-    // Retrieve cached noise
-    const NoiseCache& cached = noiseCache[coordHash];
-    const auto& terrain = cached.terrain;
-    const auto& temperature = cached.temperature;
-    const auto& humidity = cached.humidity;
-    const auto& mountain = cached.mountain;
+            const float continental = sampleContinentalNoise(wx, wz);
+            terrain[idx] = calculateHeight(sampleTerrainNoise(wx, wz), continental, sampleErosionNoise(wx, wz));
+            temperature[idx] = sampleTemperatureNoise(wx, wz);
+            humidity[idx] = sampleHumidityNoise(wx, wz);
+            mountain[idx] = continental;
+        }
+    }
 
     // Fill voxels column by column
     for (int x = 0; x < Chunk::WIDTH; ++x) {
@@ -256,26 +234,24 @@ void TerrainGenerator::generateChunk(Chunk& chunk, const glm::ivec2& coord) {
                     voxel = surfaceBlock;
                 }
 
-                chunk.setVoxelSilent(x, y, z, voxel);
+                chunk.setVoxel(x, y, z, voxel);
             }
 
             // Fill water above surface up to sea level
             if (surfaceY < SEA_LEVEL) {
                 for (int y = surfaceY + 1; y <= SEA_LEVEL && y < Chunk::HEIGHT; ++y) {
-                    chunk.setVoxelSilent(x, y, z, WATER);
+                    chunk.setVoxel(x, y, z, WATER);
                 }
             }
 
             // Snow cap for high mountains
             if (surfaceBiome != BlockType::Snow && surfaceY > SNOW_HEIGHT) {
                 if (surfaceY < Chunk::HEIGHT) {
-                    chunk.setVoxelSilent(x, surfaceY, z, SNOW);
+                    chunk.setVoxel(x, surfaceY, z, SNOW);
                 }
             }
         }
     }
-
-    chunk.markMeshDirty();
 }
 
 // ============================================================================
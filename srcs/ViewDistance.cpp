@@ -0,0 +1,61 @@
+#include "ViewDistance.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+ViewDistanceController::ViewDistanceController(const int radius, const Config& config)
+	: config(config), current(std::clamp(radius, config.minRadius, config.maxRadius))
+{
+}
+
+int ViewDistanceController::update(const float frameSeconds, const float cpuFrameSeconds, const size_t queuedJobs,
+	const size_t residentBytes)
+{
+	const float frameMs = cpuFrameSeconds * 1000.0f;
+	avgFrameMs = avgFrameMs > 0.0f ? avgFrameMs + (frameMs - avgFrameMs) * 0.1f : frameMs;
+	sinceEval += frameSeconds;
+	sinceChange += frameSeconds;
+
+	if (sinceEval < EVAL_INTERVAL || sinceChange < COOLDOWN)
+		return current;
+	sinceEval = 0.0f;
+
+	char buf[96];
+	const float residentMiB = static_cast<float>(residentBytes) / (1 << 20);
+	const float ceilingMiB = static_cast<float>(config.memoryCeiling) / (1 << 20);
+
+	auto change = [&](const int delta) {
+		current += delta;
+		sinceChange = 0.0f;
+		lastReason = buf;
+	};
+
+	if (residentBytes > config.memoryCeiling && current > config.minRadius) {
+		std::snprintf(buf, sizeof(buf), "shrunk: %.0f MiB over %.0f MiB ceiling", residentMiB, ceilingMiB);
+		change(-1);
+	}
+	else if (avgFrameMs > config.targetFrameMs * SHRINK_FACTOR && current > config.minRadius) {
+		std::snprintf(buf, sizeof(buf), "shrunk: %.1f ms frame, target %.1f ms", avgFrameMs, config.targetFrameMs);
+		change(-1);
+	}
+	else if (avgFrameMs < config.targetFrameMs * GROW_FACTOR && current < config.maxRadius) {
+		// Resident memory scales with the disc area
+		const float next = static_cast<float>(current + 1) / static_cast<float>(current);
+		const float projected = static_cast<float>(residentBytes) * next * next;
+
+		if (queuedJobs > config.maxQueuedJobs) {
+			std::snprintf(buf, sizeof(buf), "held: %zu jobs queued", queuedJobs);
+			lastReason = buf;
+		}
+		else if (projected > static_cast<float>(config.memoryCeiling)) {
+			std::snprintf(buf, sizeof(buf), "held: next ring would exceed %.0f MiB", ceilingMiB);
+			lastReason = buf;
+		}
+		else {
+			std::snprintf(buf, sizeof(buf), "grew: %.1f ms frame, target %.1f ms", avgFrameMs, config.targetFrameMs);
+			change(+1);
+		}
+	}
+
+	return current;
+}
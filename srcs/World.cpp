@@ -10,7 +10,9 @@
 
 #include "glm/gtx/norm.hpp"
 
+#include <algorithm>
 #include <ranges>
+#include <tuple>
 
 inline RenderType blockRenderType(const BlockType t)
 {
@@ -38,7 +40,9 @@ World::World(std::array<uint32_t, 256>& indices) : ubo(0), textureIndices(indice
         .MVP = glm::mat4(1.f),
         .light = {0.0f, 200.0f, 0.0f, 500.f},
         .cameraPos = {0.0f, 0.0f, 0.0f, 0.4f},
+        .fog = {},
     };
+    setChunkRadius(DEFAULT_CHUNK_RADIUS);
 }
 
 bool World::isBlockActiveWorld(const int wx, const int wy, const int wz) const {
@@ -48,14 +52,14 @@ bool World::isBlockActiveWorld(const int wx, const int wy, const int wz) const {
     int cx = floorDiv(wx, Chunk::WIDTH);
     int cz = floorDiv(wz, Chunk::DEPTH);
 
-    const auto it = chunks.find({cx, cz});
-    if (it == chunks.end())
+    const Chunk* chunk = findChunk({cx, cz});
+    if (!chunk)
         return false;
 
     const int lx = wx - cx * Chunk::WIDTH;
     const int lz = wz - cz * Chunk::DEPTH;
 
-    return it->second.isBlockActive(lx, wy, lz);
+    return chunk->isBlockActive(lx, wy, lz);
 }
 
 bool World::isBoxInFrustum(const glm::vec3& min, const glm::vec3& max) const
@@ -69,126 +73,724 @@ void World::updateFrustum(const glm::mat4& proj_mat, const glm::mat4& view_mat)
 }
 
 /* ===================== Chunk Streaming ===================== */
-void World::updateChunks(const glm::vec3& playerPos, ThreadPool& threadPool)
+void World::updateChunks(const Camera& camera, ThreadPool& threadPool)
 {
-    playerChunk = {
-        floorDiv(static_cast<int>(playerPos.x), Chunk::WIDTH),
-        floorDiv(static_cast<int>(playerPos.z), Chunk::DEPTH)
+    const ChunkCoord center = {
+        floorDiv(static_cast<int>(camera.pos.x), Chunk::WIDTH),
+        floorDiv(static_cast<int>(camera.pos.z), Chunk::DEPTH)
     };
+    playerChunk.store(center, std::memory_order_relaxed);
+    trackMotion(camera.pos);
+
+    std::vector<ChunkCoord> toLoad;
+
+    // A larger radius loads the ring between the old and new distances
+    // around where the resident set was built. Nothing is unloaded by
+    // distance: chunks left behind stay cached until the memory budget
+    // evicts them, so coming back is free
+    const bool radiusChanged = streamRadius != chunkRadius;
+    if (radiusChanged && streamCenter && chunkRadius > streamRadius)
+        forEachRadiusDelta(*streamCenter, streamRadius + LOAD_MARGIN, loadDistance(), [&](const ChunkCoord c) {
+            toLoad.push_back(c);
+        });
+    streamRadius = chunkRadius;
+
+    // Only the ring that changed is visited, and only when the player
+    // crosses a chunk border; a standing player costs nothing here
+    const bool crossedBorder = !streamCenter || *streamCenter != center;
+    if (crossedBorder) {
+        forEachRingDelta(streamCenter, center, loadDistance(), [&](const ChunkCoord c) {
+            toLoad.push_back(c);
+        });
+        streamCenter = center;
+    }
 
-    // =========================================================
-    // LOAD CHUNKS
-    // =========================================================
-    forEachChunkSpiral(playerChunk, CHUNK_RADIUS, [&](ChunkCoord c)
-    {
-        {
-            std::lock_guard lock(state_mutex);
-            auto& state = chunkStates[c];
-            if (state != ChunkState::Unloaded)
-                return;
+    const bool predictionToggled = predictionEnabled != prefetchWasEnabled;
+    if (crossedBorder || radiusChanged || predictionToggled) {
+        prefetchAlongPath(camera, center, toLoad);
+        prefetchWasEnabled = predictionEnabled;
+    }
+
+    const glm::vec3 viewDir = glm::normalize(camera.dir);
+    if (crossedBorder || radiusChanged || predictionToggled
+        || glm::dot(viewDir, rankedViewDir) < RERANK_VIEW_DOT) {
+        reprioritisePendingLoads(camera);
+        rankedViewDir = viewDir;
+    }
+
+    requestLoads(toLoad, camera, threadPool);
+    remeshDirtyChunks(threadPool);
+    meshChunksEnteringView(threadPool);
+    enforceMemoryBudget(center);
+}
+
+void World::trackMotion(const glm::vec3& pos)
+{
+    const double now = glfwGetTime();
+    const glm::vec2 posXZ(pos.x, pos.z);
+
+    // A jump of several chunks in one frame is a teleport, not motion
+    if (!motionHistory.empty()
+        && glm::distance(motionHistory.back().second, posXZ) > Chunk::WIDTH * 4.0f)
+        motionHistory.clear();
+
+    motionHistory.emplace_back(now, posXZ);
+    while (motionHistory.size() > 2 && now - motionHistory.front().first > MOTION_WINDOW)
+        motionHistory.pop_front();
+
+    const auto& [t0, p0] = motionHistory.front();
+    const auto dt = static_cast<float>(now - t0);
+    velocity = dt > 0.05f ? (posXZ - p0) / dt : glm::vec2(0.0f);
+}
 
-            state = ChunkState::Loading;
+void World::prefetchAlongPath(const Camera& camera, const ChunkCoord& center, std::vector<ChunkCoord>& toLoad)
+{
+    // Corridor of chunks along the extrapolated path, nearest first
+    std::vector<ChunkCoord> corridor;
+    std::unordered_set<ChunkCoord> inCorridor;
+
+    const float speed = glm::length(velocity);
+    if (predictionEnabled && speed >= PREFETCH_MIN_SPEED) {
+        const glm::vec2 dir = velocity / speed;
+        const glm::vec2 origin(camera.pos.x / Chunk::WIDTH, camera.pos.z / Chunk::DEPTH);
+        const float reach = std::min(speed * PREFETCH_SECONDS / Chunk::WIDTH,
+                                     static_cast<float>(loadDistance() + PREFETCH_MAX_AHEAD));
+
+        for (float s = static_cast<float>(loadDistance() - PREFETCH_HALF_WIDTH); s <= reach; s += 1.0f) {
+            const glm::vec2 point = origin + dir * s;
+            const ChunkCoord pc(static_cast<int>(std::floor(point.x)), static_cast<int>(std::floor(point.y)));
+
+            forEachRingDelta(std::nullopt, pc, PREFETCH_HALF_WIDTH, [&](const ChunkCoord c) {
+                if (!isWithinDistance(c, center, loadDistance()) && inCorridor.insert(c).second)
+                    corridor.push_back(c);
+            });
         }
+    }
 
-        threadPool.enqueue([this, c]
-        {
-            Chunk chunk;
-            chunk.worldMin = {c.x * Chunk::WIDTH, 0.0f, c.y * Chunk::DEPTH};
-            chunk.worldMax = chunk.worldMin +
-                glm::vec3(Chunk::WIDTH, Chunk::HEIGHT, Chunk::DEPTH);
+    // Forget what fell off the path or into the load disc; the chunks
+    // themselves stay cached
+    std::erase_if(prefetched, [&](const ChunkCoord& c) {
+        return !inCorridor.contains(c) || isWithinDistance(c, center, loadDistance());
+    });
 
-            generateTerrain(chunk, c);
-            generateChunkGreedyMesh(chunk, c);
+    for (const auto& c : corridor) {
+        if (prefetched.size() >= PREFETCH_BUDGET)
+            break;
+        if (prefetched.insert(c).second)
+            toLoad.push_back(c);
+    }
+}
 
-            {
-                std::lock_guard lock(chunk_mutex);
-                chunks.emplace(c, std::move(chunk));
-            }
-            {
-                std::lock_guard lock(state_mutex);
-                chunkStates[c] = ChunkState::Loaded;
-            }
-        });
+void World::updateRecordBytes(ChunkRecord& record)
+{
+    size_t bytes = record.mesh.opaque.bytes + record.mesh.transparent.bytes;
+    if (const Chunk* chunk = record.chunk.get()) {
+        bytes += sizeof(Chunk)
+            + (chunk->cachedOpaqueQuads.capacity() + chunk->cachedTransparentQuads.capacity()) * sizeof(ChunkQuad);
+    }
+    if (record.edges)
+        bytes += sizeof(EdgeSlices);
+    residentBytes += bytes - record.bytes;
+    record.bytes = bytes;
+}
+
+float World::evictionScore(const ChunkCoord& coord, const ChunkRecord& record, const ChunkCoord& center, const double now)
+{
+    // Far, long unseen chunks go first; edits are lost on eviction, so an
+    // edited chunk has to be much further gone before it qualifies
+    const float dist = glm::length(glm::vec2(coord - center));
+    const auto unseen = static_cast<float>(now - record.lastVisible);
+    float score = dist + unseen * EVICT_UNSEEN_WEIGHT;
+    if (record.chunk && record.chunk->edited)
+        score *= EVICT_EDITED_FACTOR;
+    return score;
+}
+
+void World::enforceMemoryBudget(const ChunkCoord& center)
+{
+    if (residentBytes <= memoryBudget)
+        return;
+
+    // Only chunks outside the load disc are candidates; if the disc alone
+    // does not fit, the view distance controller shrinks it
+    const double now = glfwGetTime();
+    std::vector<std::tuple<float, ChunkCoord, size_t>> candidates;
+    {
+        std::lock_guard lock(chunk_mutex);
+        for (const auto& [c, record] : chunks)
+            if (!isWithinDistance(c, center, loadDistance()))
+                candidates.emplace_back(evictionScore(c, record, center, now), c, record.bytes);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return std::get<0>(a) > std::get<0>(b);
     });
 
-    // =========================================================
-    // REGENERATE DIRTY CHUNKS
-    // =========================================================
+    // Evict down to a low-water mark so this does not run every frame
+    const size_t target = memoryBudget / 10 * 9;
+    size_t remaining = residentBytes;
+    std::vector<ChunkCoord> victims;
+    for (const auto& [score, c, bytes] : candidates) {
+        if (remaining <= target)
+            break;
+        victims.push_back(c);
+        prefetched.erase(c);
+        remaining -= bytes;
+    }
+
+    evictedChunks += victims.size();
+    unloadChunks(victims);
+}
+
+void World::setChunkRadius(const int radius)
+{
+    chunkRadius = std::clamp(radius, MIN_CHUNK_RADIUS, MAX_CHUNK_RADIUS);
+
+    // Fog reaches full density at the edge of the loaded disc so the
+    // far plane never cuts through visible terrain
+    const float edge = static_cast<float>(chunkRadius * Chunk::WIDTH);
+    worldUBO.fog = {edge * 0.68f, edge, 0.0f, 0.0f};
+}
+
+float World::getFarPlane() const
+{
+    return static_cast<float>((loadDistance() + 1) * Chunk::WIDTH + Chunk::HEIGHT);
+}
+
+Chunk* World::findChunk(const ChunkCoord& coord)
+{
+    const auto it = chunks.find(coord);
+    return it != chunks.end() ? it->second.chunk.get() : nullptr;
+}
+
+const Chunk* World::findChunk(const ChunkCoord& coord) const
+{
+    const auto it = chunks.find(coord);
+    return it != chunks.end() ? it->second.chunk.get() : nullptr;
+}
+
+// Null while the chunk is not loaded. Only faces written since they were
+// last taken are read from the voxels again
+const EdgeSlice* World::edgeSlice(const ChunkCoord& coord, const Chunk::Face face)
+{
+    const auto it = chunks.find(coord);
+    if (it == chunks.end() || !it->second.chunk)
+        return nullptr;
+
+    ChunkRecord& record = it->second;
+    if (!record.edges) {
+        record.edges = std::make_unique<EdgeSlices>();
+        updateRecordBytes(record);
+    }
+
+    const Chunk& chunk = *record.chunk;
+    EdgeSlice& slice = (*record.edges)[face];
+    if (slice.version == chunk.edgeVersion(face))
+        return &slice;
+
+    const int x = face == Chunk::POS_X ? Chunk::WIDTH - 1 : 0;
+    const int z = face == Chunk::POS_Z ? Chunk::DEPTH - 1 : 0;
+    const bool alongX = face == Chunk::NEG_Z || face == Chunk::POS_Z;
+    for (int y = 0; y < Chunk::HEIGHT; ++y)
+        for (int c = 0; c < EdgeSlice::CELLS; ++c) {
+            const uint8_t bt = getBlockType(alongX ? chunk.getVoxel(c, y, z) : chunk.getVoxel(x, y, c));
+            slice.types[y * EdgeSlice::CELLS + c] = bt;
+            slice.render[y * EdgeSlice::CELLS + c] = bt ? blockRenderType(static_cast<BlockType>(bt)) : RenderType::Air;
+        }
+    slice.version = chunk.edgeVersion(face);
+    return &slice;
+}
+
+void World::requestLoads(const std::vector<ChunkCoord>& coords, const Camera& camera, ThreadPool& threadPool)
+{
+    if (coords.empty())
+        return;
+
+    const double now = glfwGetTime();
+    std::vector<PendingChunk> batch;
+    batch.reserve(coords.size());
+
+    {
+        std::lock_guard lock(chunk_mutex);
+        for (const auto& c : coords) {
+            auto [it, inserted] = chunks.try_emplace(c);
+            if (!inserted)
+                continue;
+
+            it->second.generation = nextGeneration++;
+            it->second.lastVisible = now;
+            batch.push_back({c, 0.0f, now, it->second.generation, false});
+        }
+    }
+
+    {
+        std::lock_guard lock(schedule_mutex);
+        for (auto& pending : batch) {
+            pending.priority = loadPriority(pending.coord, camera.pos, camera.dir, pending.inView);
+            pendingLoads.push_back(pending);
+            std::ranges::push_heap(pendingLoads, std::greater{}, &PendingChunk::priority);
+        }
+    }
+
+    // Tasks are interchangeable: each one pulls whatever is most urgent
+    // at the moment a worker becomes free
+    threadPool.submitBatch(batch.size(), [this, &threadPool](size_t) {
+        return [this, &threadPool] { loadNextChunk(threadPool); };
+    }, ThreadPool::Lane::Streaming, ThreadPool::Tag::Generate);
+}
+
+void World::unloadChunks(const std::vector<ChunkCoord>& coords)
+{
+    if (coords.empty())
+        return;
+
+    // Erasing the record is the whole unload: any job still working on it
+    // fails its generation check, and the GL handles go back right here on
+    // the render thread
+    std::lock_guard lock(chunk_mutex);
+    for (const auto& c : coords) {
+        const auto it = chunks.find(c);
+        if (it == chunks.end())
+            continue;
+
+        if (it->second.state == ChunkState::Loading)
+            ++cancelledLoads;
+
+        // Neighbours still waiting to mesh need this chunk again
+        if (it->second.chunk)
+            for (const auto& side : SIDE_OFFSETS)
+                if (const auto n = chunks.find(c + side); n != chunks.end() && n->second.state == ChunkState::Generated)
+                    ++n->second.missingNeighbours;
+
+        releaseMesh(it->second.mesh);
+        residentBytes -= it->second.bytes;
+        awaitingView.erase(c);
+        chunks.erase(it);
+    }
+}
+
+void World::releaseMesh(Chunk::ChunkRenderData& mesh)
+{
+    for (auto* batch : {&mesh.opaque, &mesh.transparent}) {
+        if (batch->vao)
+            glDeleteVertexArrays(1, &batch->vao);
+        if (batch->vbo)
+            VBOManager::get().returnVBO(batch->vbo);
+        *batch = {};
+    }
+}
+
+void World::markChunkDirty(const ChunkCoord& coord, const Chunk::SectionMask sections)
+{
+    dirtyChunks.push_back(coord);
+
+    const auto it = chunks.find(coord);
+    if (it == chunks.end())
+        return;
+    it->second.remeshSections |= sections;
+    if (it->second.editedAt == 0.0)
+        it->second.editedAt = glfwGetTime();
+}
+
+void World::remeshDirtyChunks(ThreadPool& threadPool)
+{
+    std::vector<ChunkCoord> ready;
     {
-        std::lock_guard stateLock(state_mutex);
+        std::lock_guard lock(chunk_mutex);
+        if (dirtyChunks.empty())
+            return;
+
+        std::vector<ChunkCoord> dirty;
+        dirty.swap(dirtyChunks);
 
-        for (auto& [c, state] : chunkStates) {
-            if (state != ChunkState::Loaded)
+        std::sort(dirty.begin(), dirty.end(), [](const ChunkCoord& a, const ChunkCoord& b) { return a < b; });
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+        for (const auto& c : dirty) {
+            const auto it = chunks.find(c);
+            if (it == chunks.end())
                 continue;
 
-            bool dirty = false;
-            {
-                std::lock_guard chunkLock(chunk_mutex);
-                dirty = chunks.at(c).isMeshDirty;
+            // An edit landing mid-mesh needs another pass once that one is
+            // done; a chunk not meshed yet will pick the edit up anyway
+            if (it->second.state == ChunkState::NeighboursReady)
+                dirtyChunks.push_back(c);
+            else if (it->second.state == ChunkState::Meshed || it->second.state == ChunkState::Uploaded)
+                ready.push_back(c);
+        }
+    }
+    // The player is looking at the edit: jump the streaming backlog
+    scheduleMeshes(ready, threadPool, ThreadPool::Lane::Interactive);
+}
+
+void World::remeshAll(ThreadPool& threadPool)
+{
+    std::vector<ChunkCoord> ready;
+    {
+        std::lock_guard lock(chunk_mutex);
+        for (auto& [coord, record] : chunks) {
+            if (record.state == ChunkState::Meshed || record.state == ChunkState::Uploaded) {
+                record.remeshSections = Chunk::ALL_SECTIONS;
+                ready.push_back(coord);
             }
+        }
+    }
+    scheduleMeshes(ready, threadPool);
+}
 
-            if (!dirty)
+bool World::isNearPlayer(const ChunkCoord& coord) const
+{
+    const int near = std::max(LAZY_MESH_NEAR, eagerMeshRadius.load(std::memory_order_relaxed));
+    return isWithinDistance(coord, playerChunk.load(std::memory_order_relaxed), near);
+}
+
+void World::meshChunksEnteringView(ThreadPool& threadPool)
+{
+    std::vector<ChunkCoord> ready;
+    {
+        std::lock_guard lock(chunk_mutex);
+        if (awaitingView.empty())
+            return;
+
+        // The margin grows the box rather than the frustum, which amounts to
+        // the same look-ahead for turning and moving
+        const glm::vec3 margin(LAZY_MESH_MARGIN, 0.0f, LAZY_MESH_MARGIN);
+        std::erase_if(awaitingView, [&](const ChunkCoord& c) {
+            const glm::vec3 min(c.x * Chunk::WIDTH, 0.0f, c.y * Chunk::DEPTH);
+            const glm::vec3 max = min + glm::vec3(Chunk::WIDTH, Chunk::HEIGHT, Chunk::DEPTH);
+            if (!isNearPlayer(c) && !frustum.isBoxInFrustum(min - margin, max + margin))
+                return false;
+            ready.push_back(c);
+            return true;
+        });
+    }
+    scheduleMeshes(ready, threadPool);
+}
+
+void World::scheduleMeshes(const std::span<const ChunkCoord> ready, ThreadPool& threadPool, const ThreadPool::Lane lane)
+{
+    if (ready.empty())
+        return;
+
+    struct MeshJob {
+        ChunkCoord coord;
+        uint32_t generation;
+    };
+    ScratchArena::Scope scope;
+    ScratchVector<MeshJob> jobs(ready.size());
+    {
+        std::lock_guard lock(chunk_mutex);
+        for (const auto& c : ready) {
+            const auto it = chunks.find(c);
+            if (it == chunks.end())
                 continue;
 
-            state = ChunkState::Meshing;
+            // Already queued, or a neighbour was unloaded in the meantime
+            const auto& record = it->second;
+            if (record.state == ChunkState::Loading || record.state == ChunkState::NeighboursReady
+                || (record.state == ChunkState::Generated && record.missingNeighbours > 0))
+                continue;
 
-            threadPool.enqueue([this, c]
-            {
-                Chunk copy;
-                {
-                    std::lock_guard lock(chunk_mutex);
-                    copy = chunks.at(c);
-                }
+            it->second.state = ChunkState::NeighboursReady;
+            jobs.push_back({c, it->second.generation});
+        }
+    }
 
-                generateChunkGreedyMesh(copy, c);
+    threadPool.submitBatch(jobs.size(), [this, &jobs](const size_t i) {
+        return [this, c = jobs[i].coord, generation = jobs[i].generation] { meshChunk(c, generation); };
+    }, lane, ThreadPool::Tag::Mesh);
+}
 
-                {
-                    std::lock_guard lock(chunk_mutex);
-                    auto& dst = chunks.at(c);
-                    dst.cachedOpaqueVertices = std::move(copy.cachedOpaqueVertices);
-                    dst.cachedOpaqueIndices = std::move(copy.cachedOpaqueIndices);
-                    dst.cachedTransparentIndices = std::move(copy.cachedTransparentIndices);
-                    dst.cachedTransparentVertices = std::move(copy.cachedTransparentVertices);
-                    dst.isMeshDirty = copy.isMeshDirty;
-                    dst.aoCalculated.store(copy.aoCalculated);
-                }
-                {
-                    std::lock_guard lock(state_mutex);
-                    chunkStates[c] = ChunkState::Loaded;
-                }
-            });
+// Layers y0..y1 of a chunk's voxels, z slab by z slab
+static void copyLayers(const Voxel* src, Voxel* dst, const int y0, const int y1)
+{
+    constexpr int W = Chunk::WIDTH;
+    constexpr int H = Chunk::HEIGHT;
+    for (int z = 0; z < Chunk::DEPTH; ++z)
+        std::copy_n(src + y0 * W + z * W * H, (y1 - y0 + 1) * W, dst + y0 * W + z * W * H);
+}
+
+// Folds a newer partial mesh into one still waiting for upload, into
+// `fresh`; sections in both come from the newer one
+static void mergeSections(const std::vector<ChunkQuad>& pending, const std::array<uint32_t, Chunk::SECTIONS>& pendingCounts,
+    const Chunk::SectionMask pendingSections, std::vector<ChunkQuad>& fresh, std::array<uint32_t, Chunk::SECTIONS>& freshCounts,
+    const Chunk::SectionMask freshSections)
+{
+    std::vector<ChunkQuad> merged;
+    std::array<uint32_t, Chunk::SECTIONS> counts{};
+    size_t pendingAt = 0;
+    size_t freshAt = 0;
+    for (int s = 0; s < Chunk::SECTIONS; ++s) {
+        if (freshSections >> s & 1) {
+            counts[s] = freshCounts[s];
+            merged.insert(merged.end(), fresh.begin() + freshAt, fresh.begin() + freshAt + counts[s]);
+        }
+        else if (pendingSections >> s & 1) {
+            counts[s] = pendingCounts[s];
+            merged.insert(merged.end(), pending.begin() + pendingAt, pending.begin() + pendingAt + counts[s]);
         }
+        freshAt += freshCounts[s];
+        pendingAt += pendingCounts[s];
     }
+    fresh.swap(merged);
+    freshCounts = counts;
+}
 
-    // =========================================================
-    // UNLOAD FAR CHUNKS
-    // =========================================================
+void World::meshChunk(const ChunkCoord& c, const uint32_t generation)
+{
+    ScratchArena::Scope scope;
+    Voxel* voxels = ScratchArena::local().allocate<Voxel>(Chunk::SIZE);
+    Chunk::SectionMask sections;
+    double editedAt;
     {
-        std::lock_guard stateLock(state_mutex);
+        std::lock_guard lock(chunk_mutex);
+        const auto it = chunks.find(c);
+        if (it == chunks.end() || it->second.generation != generation)
+            return;
+
+        // Edits name the sections they touch; anything else rebuilds them all
+        sections = Chunk::sectionSpan(it->second.remeshSections ? it->second.remeshSections : Chunk::ALL_SECTIONS);
+        it->second.remeshSections = 0;
+
+        const int y0 = std::countr_zero(sections) * Chunk::SECTION_HEIGHT;
+        const int y1 = std::bit_width(sections) * Chunk::SECTION_HEIGHT - 1;
+        copyLayers(it->second.chunk->getVoxels().data(), voxels, std::max(y0 - 1, 0), std::min(y1 + 1, Chunk::HEIGHT - 1));
+        editedAt = it->second.editedAt;
+        it->second.editedAt = 0.0;
+    }
 
-        for (auto& [c, state] : chunkStates) {
-            if (state != ChunkState::Loaded)
-                continue;
+    ScratchVector<ChunkQuad> opaque(MESH_SCRATCH_QUADS);
+    ScratchVector<ChunkQuad> transparent(MESH_SCRATCH_QUADS);
+    std::array<uint32_t, Chunk::SECTIONS> opaqueCounts{};
+    std::array<uint32_t, Chunk::SECTIONS> transparentCounts{};
+    buildGreedyMesh(std::span<const Voxel, Chunk::SIZE>(voxels, Chunk::SIZE), c, mesher.load(std::memory_order_relaxed),
+        sections, {opaque, opaqueCounts}, {transparent, transparentCounts});
 
-            if (glm::distance(glm::vec2(c), glm::vec2(playerChunk))
-                <= CHUNK_RADIUS + 1)
-                continue;
+    // Exactly sized, the only heap memory a mesh job asks for; the replaced
+    // mesh is freed after the lock is released
+    std::vector<ChunkQuad> opaqueQuads(opaque.begin(), opaque.end());
+    std::vector<ChunkQuad> transparentQuads(transparent.begin(), transparent.end());
+
+    uint32_t version;
+    {
+        std::lock_guard lock(chunk_mutex);
+        const auto it = chunks.find(c);
+        if (it == chunks.end() || it->second.generation != generation)
+            return;
+
+        auto& dst = *it->second.chunk;
+        if (dst.meshedSections & ~sections) {
+            mergeSections(dst.cachedOpaqueQuads, dst.opaqueSectionQuads, dst.meshedSections,
+                opaqueQuads, opaqueCounts, sections);
+            mergeSections(dst.cachedTransparentQuads, dst.transparentSectionQuads, dst.meshedSections,
+                transparentQuads, transparentCounts, sections);
+        }
+        dst.cachedOpaqueQuads.swap(opaqueQuads);
+        dst.cachedTransparentQuads.swap(transparentQuads);
+        dst.opaqueSectionQuads = opaqueCounts;
+        dst.transparentSectionQuads = transparentCounts;
+        dst.meshedSections |= sections;
+        version = ++dst.meshVersion;
+        it->second.state = ChunkState::Meshed;
+        // A newer mesh supersedes an unuploaded one, so it inherits its edit
+        if (editedAt > 0.0 && (it->second.meshedEditAt == 0.0 || editedAt < it->second.meshedEditAt))
+            it->second.meshedEditAt = editedAt;
+        updateRecordBytes(it->second);
+        editedAt = it->second.meshedEditAt;
+    }
+    (editedAt > 0.0 ? completedEdits : completedMeshes).push({c, version});
+}
 
-            state = ChunkState::Unloading;
+/* ===================== Load Scheduling ===================== */
+float World::loadPriority(const ChunkCoord& coord, const glm::vec3& camPos, const glm::vec3& camDir, bool& inView) const
+{
+    const glm::vec3 min(coord.x * Chunk::WIDTH, 0.0f, coord.y * Chunk::DEPTH);
+    const glm::vec3 max = min + glm::vec3(Chunk::WIDTH, Chunk::HEIGHT, Chunk::DEPTH);
+    inView = frustum.isBoxInFrustum(min, max);
+
+    const glm::vec2 chunkCenter(min.x + Chunk::WIDTH * 0.5f, min.z + Chunk::DEPTH * 0.5f);
+    const glm::vec2 toChunk = chunkCenter - glm::vec2(camPos.x, camPos.z);
+    const float dist = glm::length(toChunk) / Chunk::WIDTH;
+
+    // Facing in [-1, 1]; the chunk under the player has no direction
+    float facing = 0.0f;
+    const glm::vec2 viewXZ(camDir.x, camDir.z);
+    if (dist > 1.0f && glm::length(viewXZ) > 0.001f)
+        facing = glm::dot(toChunk / (dist * Chunk::WIDTH), glm::normalize(viewXZ));
+
+    // When moving, distance is measured from where the player is about to be
+    float rankDist = dist;
+    if (predictionEnabled) {
+        const glm::vec2 lead = glm::vec2(camPos.x, camPos.z) + velocity * PRIORITY_LEAD_SECONDS;
+        rankDist = glm::length(chunkCenter - lead) / Chunk::WIDTH;
+    }
 
-            threadPool.enqueue([this, c]
-            {
-                {
-                    std::lock_guard lock(chunk_mutex);
-                    chunks.erase(c);
-                }
-                {
-                    std::lock_guard lock(state_mutex);
-                    chunkStates[c] = ChunkState::Unloaded;
-                }
-            });
+    // Distance dominates, view direction orders chunks within a ring and
+    // anything outside the frustum waits behind everything inside it,
+    // except chunks on the predicted path
+    float priority = rankDist * (1.5f - 0.5f * facing);
+    if (!inView && dist > 1.5f && !prefetched.contains(coord))
+        priority += chunkRadius * 2.0f;
+
+    return priority;
+}
+
+void World::reprioritisePendingLoads(const Camera& camera)
+{
+    const double now = glfwGetTime();
+    const ChunkCoord center = playerChunk.load(std::memory_order_relaxed);
+
+    // Loads that fell past the unload ring are dropped together with their
+    // record, unless they were prefetched
+    std::vector<PendingChunk> dropped;
+    std::unique_lock lock(schedule_mutex);
+    std::erase_if(pendingLoads, [&](const PendingChunk& pending) {
+        if (isWithinDistance(pending.coord, center, unloadDistance()) || prefetched.contains(pending.coord))
+            return false;
+        dropped.push_back(pending);
+        return true;
+    });
+
+    for (auto& pending : pendingLoads) {
+        bool inView = false;
+        pending.priority = loadPriority(pending.coord, camera.pos, camera.dir, inView);
+
+        // Time-to-visible counts from the moment a chunk is wanted on screen
+        if (inView && !pending.inView)
+            pending.requestedAt = now;
+        pending.inView = inView;
+    }
+    std::ranges::make_heap(pendingLoads, std::greater{}, &PendingChunk::priority);
+    lock.unlock();
+
+    if (dropped.empty())
+        return;
+
+    std::lock_guard chunkLock(chunk_mutex);
+    for (const auto& pending : dropped) {
+        const auto it = chunks.find(pending.coord);
+        if (it != chunks.end() && it->second.generation == pending.generation && !it->second.chunk)
+            chunks.erase(it);
+    }
+    cancelledLoads += dropped.size();
+}
+
+bool World::isLoadWanted(const ChunkCoord& coord, const uint32_t generation)
+{
+    std::lock_guard lock(chunk_mutex);
+    const auto it = chunks.find(coord);
+    return it != chunks.end() && it->second.generation == generation;
+}
+
+void World::loadNextChunk(ThreadPool& threadPool)
+{
+    PendingChunk job{};
+    {
+        std::lock_guard lock(schedule_mutex);
+        if (pendingLoads.empty())
+            return;
+
+        std::ranges::pop_heap(pendingLoads, std::greater{}, &PendingChunk::priority);
+        job = pendingLoads.back();
+        pendingLoads.pop_back();
+    }
+
+    const ChunkCoord c = job.coord;
+
+    // The player may have moved on while this job sat in the queue; check
+    // again before and after every expensive stage
+    if (!isLoadWanted(c, job.generation)) {
+        ++cancelledLoads;
+        return;
+    }
+
+    auto chunk = std::make_unique<Chunk>();
+    chunk->worldMin = {c.x * Chunk::WIDTH, 0.0f, c.y * Chunk::DEPTH};
+    chunk->worldMax = chunk->worldMin +
+        glm::vec3(Chunk::WIDTH, Chunk::HEIGHT, Chunk::DEPTH);
+    chunk->requestedAt = job.requestedAt;
+    chunk->requestedInView = job.inView;
+
+    generateTerrain(*chunk, c);
+
+    // Count the neighbours this chunk still waits on, and release any
+    // neighbour that was only waiting on this one
+    ScratchArena::Scope scope;
+    ScratchVector<ChunkCoord> ready(SIDE_OFFSETS.size() + 1);
+    {
+        std::lock_guard lock(chunk_mutex);
+        const auto it = chunks.find(c);
+        if (it == chunks.end() || it->second.generation != job.generation) {
+            ++wastedGenerations;
+            return;
+        }
+
+        auto& record = it->second;
+        record.chunk = std::move(chunk);
+        record.state = ChunkState::Generated;
+        record.missingNeighbours = 0;
+        updateRecordBytes(record);
+
+        for (const auto& side : SIDE_OFFSETS) {
+            const auto n = chunks.find(c + side);
+            if (n == chunks.end() || !n->second.chunk)
+                ++record.missingNeighbours;
+            else if (n->second.state == ChunkState::Generated && --n->second.missingNeighbours == 0)
+                ready.push_back(c + side);
         }
+        if (record.missingNeighbours == 0)
+            ready.push_back(c);
+
+        // Meshing is lazy: chunks right around the player go now, the rest
+        // wait until the render thread sees them come into view
+        const auto lazy = std::ranges::remove_if(ready, [&](const ChunkCoord& r) {
+            if (isNearPlayer(r))
+                return false;
+            awaitingView.insert(r);
+            return true;
+        });
+        ready.resize(ready.size() - lazy.size());
+    }
+    ++usefulGenerations;
+
+    scheduleMeshes(ready, threadPool);
+}
+
+void World::recordTimeToVisible(const Chunk& chunk)
+{
+    if (!chunk.requestedInView)
+        return;
+
+    const auto elapsed = static_cast<float>(glfwGetTime() - chunk.requestedAt);
+
+    std::lock_guard lock(schedule_mutex);
+    stats.lastTimeToVisible = elapsed;
+    stats.avgTimeToVisible = stats.visibleLoads
+        ? glm::mix(stats.avgTimeToVisible, elapsed, 0.05f)
+        : elapsed;
+    ++stats.visibleLoads;
+}
+
+StreamingStats World::getStreamingStats()
+{
+    size_t awaiting;
+    {
+        std::lock_guard chunkLock(chunk_mutex);
+        awaiting = awaitingView.size();
     }
+
+    std::lock_guard lock(schedule_mutex);
+    stats.pendingLoads = pendingLoads.size();
+    stats.cancelledLoads = cancelledLoads;
+    stats.wastedGenerations = wastedGenerations;
+    stats.usefulGenerations = usefulGenerations;
+    stats.prefetchedChunks = prefetched.size();
+    stats.residentBytes = residentBytes;
+    stats.awaitingView = awaiting;
+    stats.memoryBudget = memoryBudget;
+    stats.evictedChunks = evictedChunks;
+    stats.speed = glm::length(velocity);
+    return stats;
 }
 
 /* ===================== Terrain ===================== */
@@ -200,13 +802,12 @@ void World::generateTerrain(Chunk& chunk, const ChunkCoord& coord)
 
 /* ===================== Greedy Meshing ===================== */
 void World::buildMask(
-    const RenderType targetType,
     const int axis,
     RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
     uint8_t blockTypes[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
-    const int dims[3],
+    const int lo[3], const int size[3],
     int x[3], const int q[3],
-    std::vector<MaskEntry>& mask
+    MaskEntry* mask
 )
 {
     const int u = (axis + 1) % 3;
@@ -214,8 +815,8 @@ void World::buildMask(
 
     int n = 0;
 
-    for (x[v] = 0; x[v] < dims[v]; ++x[v])
-        for (x[u] = 0; x[u] < dims[u]; ++x[u])
+    for (x[v] = lo[v]; x[v] < lo[v] + size[v]; ++x[v])
+        for (x[u] = lo[u]; x[u] < lo[u] + size[u]; ++x[u])
         {
             const int cx = x[0];
             const int cy = x[1];
@@ -230,36 +831,44 @@ void World::buildMask(
 
             const uint8_t bt = blockTypes[cx + 1][cy + 1][cz + 1];
             const uint8_t btNeighbor = blockTypes[nx + 1][ny + 1][nz + 1];
-            bool visible = bt != 0 && self == targetType && shouldRenderFace(self, neighbor);
+            bool visible = bt != 0 && shouldRenderFace(self, neighbor);
 
-            if (visible && targetType == RenderType::Transparent && btNeighbor != 0) {
+            // Water only shows against air
+            if (visible && self == RenderType::Transparent && btNeighbor != 0) {
                 visible = false;
             }
 
             mask[n].visible = visible;
             mask[n].blockType = bt;
+            mask[n].ao = visible && self == RenderType::Opaque ? faceAO(renderType, axis, q[axis], x) : ChunkQuad::AO_LIT;
             ++n;
         }
 }
 
 void World::runGreedyPass(
-    const RenderType targetType,
     RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
     uint8_t blockTypes[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
-    const MeshTarget target
+    const MeshTarget opaque,
+    const MeshTarget transparent,
+    const int yMin, const int yMax
 ) const
 {
     constexpr int W = Chunk::WIDTH;
     constexpr int H = Chunk::HEIGHT;
     constexpr int D = Chunk::DEPTH;
 
-    constexpr int dims[3] = { W, H, D };
+    // Everything outside the band is air, so it has no faces of its own
+    const int lo[3] = { 0, yMin, 0 };
+    const int size[3] = { W, yMax - yMin + 1, D };
 
-    auto normalToIndex = [](const int axis, const int dir) -> uint8_t {
-        return axis * 2 + (dir < 0 ? 1 : 0);
-    };
+    // No scope of its own: the targets grow while it runs, so its scratch
+    // goes with the caller's
+    MaskEntry* mask = ScratchArena::local().allocate<MaskEntry>(std::max({W, H, D}) * std::max({W, H, D}));
 
-    std::vector<MaskEntry> mask(std::max({W, H, D}) * std::max({W, H, D}));
+    // First cell past the section of `cell` along dim; only Y is split
+    auto sectionEnd = [](const int dim, const int cell) {
+        return dim == 1 ? (cell / Chunk::SECTION_HEIGHT + 1) * Chunk::SECTION_HEIGHT : std::numeric_limits<int>::max();
+    };
 
     for (int axis = 0; axis < 3; ++axis)
     {
@@ -273,84 +882,57 @@ void World::runGreedyPass(
         {
             q[axis] = dir;
 
-            for (x[axis] = 0; x[axis] < dims[axis]; ++x[axis])
+            for (x[axis] = lo[axis]; x[axis] < lo[axis] + size[axis]; ++x[axis])
             {
-                const int maskSize = dims[u] * dims[v];
-                std::fill_n(mask.begin(), maskSize, MaskEntry{false, 0});
+                const int maskSize = size[u] * size[v];
+                std::fill_n(mask, maskSize, MaskEntry{false, 0, 0});
 
-                buildMask(targetType, axis, renderType, blockTypes , const_cast<int*>(dims), x, q, mask);
+                buildMask(axis, renderType, blockTypes, lo, size, x, q, mask);
 
                 int n = 0;
-                uint32_t base = target.vertices.size();
 
-                for (int j = 0; j < dims[v]; ++j)
+                for (int j = 0; j < size[v]; ++j)
                 {
-                    for (int i = 0; i < dims[u];)
+                    for (int i = 0; i < size[u];)
                     {
                         if (!mask[n].visible) { ++i; ++n; continue; }
 
                         const uint8_t bt = mask[n].blockType;
+                        const uint8_t ao = mask[n].ao;
 
                         int w = 1;
                         int h = 1;
 
-                        while (i + w < dims[u] &&
+                        // Quads stop at section boundaries, so each belongs to one section
+                        const int maxW = std::min(size[u] - i, sectionEnd(u, lo[u] + i) - (lo[u] + i));
+                        const int maxH = std::min(size[v] - j, sectionEnd(v, lo[v] + j) - (lo[v] + j));
+
+                        while (w < maxW &&
                                mask[n + w].visible &&
-                               mask[n + w].blockType == bt)
+                               mask[n + w].blockType == bt &&
+                               mask[n + w].ao == ao)
                             ++w;
 
-                        for (; j + h < dims[v]; ++h)
+                        for (; h < maxH; ++h)
                         {
                             for (int k = 0; k < w; ++k)
-                                if (!mask[n + k + h * dims[u]].visible ||
-                                    mask[n + k + h * dims[u]].blockType != bt)
+                                if (!mask[n + k + h * size[u]].visible ||
+                                    mask[n + k + h * size[u]].blockType != bt ||
+                                    mask[n + k + h * size[u]].ao != ao)
                                     goto merge_done;
                         }
                         merge_done:
 
-                        x[u] = i;
-                        x[v] = j;
-
-                        float verts[4][3];
-                        for (auto& vtx : verts)
-                        {
-                            vtx[0] = x[0];
-                            vtx[1] = x[1];
-                            vtx[2] = x[2];
-                        }
-
-                        verts[1][u] += w;
-                        verts[2][u] += w; verts[2][v] += h;
-                        verts[3][v] += h;
-
-                        if (dir > 0)
-                            for (auto& vtx : verts) vtx[axis] += 1.0f;
-
-                        float uv[4][2] = {{0, 0},{(float)w, 0},{(float)w, (float)h},{0, (float)h}};
-
-                        const uint16_t tex = textureIndices[bt];
-                        const uint8_t normal = normalToIndex(axis, dir);
-                        constexpr uint8_t AO_MAX = 3;
-
-                        for (int k = 0; k < 4; ++k)
-                            target.vertices.push_back({
-                                {verts[k][0], verts[k][1], verts[k][2]},
-                                {uv[k][0], uv[k][1]},
-                                tex, normal, AO_MAX
-                            });
-
-                        if (dir > 0)
-                            target.indices.insert(target.indices.end(),
-                                {base, base+1, base+2, base, base+2, base+3});
-                        else
-                            target.indices.insert(target.indices.end(),
-                                {base, base+3, base+2, base, base+2, base+1});
+                        // Same type means same target, so merged quads never mix the two
+                        x[u] = lo[u] + i;
+                        x[v] = lo[v] + j;
+                        const bool water = blockRenderType(static_cast<BlockType>(bt)) == RenderType::Transparent;
+                        emitGreedyQuad(water ? transparent : opaque, axis, dir, x, w, h, textureIndices[bt], ao);
 
                         for (int dy = 0; dy < h; ++dy)
                             for (int dx = 0; dx < w; ++dx)
-                                mask[n + dx + dy * dims[u]].visible = false;
+                                mask[n + dx + dy * size[u]].visible = false;
 
-                        base += 4;
                         i += w;
                         n += w;
                     }
@@ -360,115 +942,160 @@ void World::runGreedyPass(
     }
 }
 
-void World::generateChunkGreedyMesh(Chunk& chunk, const ChunkCoord& coord)
+void World::emitGreedyQuad(const MeshTarget target, const int axis, const int dir, const int pos[3], const int w, const int h, const uint16_t tex, const uint8_t ao)
+{
+    const uint8_t normal = axis * 2 + (dir < 0 ? 1 : 0);
+    target.quads.push_back(ChunkQuad::pack(pos[0], pos[1], pos[2], normal, w, h, tex, ao));
+}
+
+uint8_t World::faceAO(
+    const RenderType renderType[Chunk::WIDTH + 2][Chunk::HEIGHT + 2][Chunk::DEPTH + 2],
+    const int axis, const int dir, const int cell[3]
+)
+{
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+
+    // The 3x3 ring around the open cell in front of the face, padded coordinates
+    int open[3] = {cell[0] + 1, cell[1] + 1, cell[2] + 1};
+    open[axis] += dir;
+
+    bool occludes[3][3];
+    for (int du = -1; du <= 1; ++du)
+        for (int dv = -1; dv <= 1; ++dv)
+        {
+            int p[3] = {open[0], open[1], open[2]};
+            p[u] += du;
+            p[v] += dv;
+            occludes[du + 1][dv + 1] = renderType[p[0]][p[1]][p[2]] == RenderType::Opaque;
+        }
+
+    uint8_t ao = 0;
+    for (int k = 0; k < 4; ++k)
+    {
+        const int corner = ChunkQuad::CORNERS[dir < 0][k];
+        const int su = corner == 1 || corner == 2 ? 2 : 0;
+        const int sv = corner >= 2 ? 2 : 0;
+        const int darkness = occludes[su][1] + occludes[1][sv] + occludes[su][sv];
+        ao |= std::max(1, 3 - darkness) << (2 * k);     // never fully dark
+    }
+    return ao;
+}
+
+void World::generateChunkGreedyMesh(Chunk& chunk, const ChunkCoord& coord, const Mesher kind)
+{
+    ScratchArena::Scope scope;
+    ScratchVector<ChunkQuad> opaque(MESH_SCRATCH_QUADS);
+    ScratchVector<ChunkQuad> transparent(MESH_SCRATCH_QUADS);
+    buildGreedyMesh(chunk.getVoxels(), coord, kind, Chunk::ALL_SECTIONS,
+        {opaque, chunk.opaqueSectionQuads}, {transparent, chunk.transparentSectionQuads});
+
+    chunk.cachedOpaqueQuads = std::vector<ChunkQuad>(opaque.begin(), opaque.end());
+    chunk.cachedTransparentQuads = std::vector<ChunkQuad>(transparent.begin(), transparent.end());
+    chunk.meshedSections = Chunk::ALL_SECTIONS;
+}
+
+// Stable counting sort of the target's quads by section
+static void groupBySection(const MeshTarget target)
+{
+    auto& counts = target.sectionQuads;
+    counts.fill(0);
+    for (const ChunkQuad& quad : target.quads)
+        ++counts[quad.y() / Chunk::SECTION_HEIGHT];
+
+    std::array<uint32_t, Chunk::SECTIONS> next{};
+    for (int s = 1; s < Chunk::SECTIONS; ++s)
+        next[s] = next[s - 1] + counts[s - 1];
+
+    ScratchArena::Scope scope;
+    ChunkQuad* emitted = ScratchArena::local().allocate<ChunkQuad>(target.quads.size());
+    std::ranges::copy(target.quads, emitted);
+    for (size_t q = 0; q < target.quads.size(); ++q)
+        target.quads[next[emitted[q].y() / Chunk::SECTION_HEIGHT]++] = emitted[q];
+}
+
+void World::buildGreedyMesh(const std::span<const Voxel, Chunk::SIZE> voxels, const ChunkCoord& coord, const Mesher kind,
+    const Chunk::SectionMask sections, const MeshTarget opaque, const MeshTarget transparent)
 {
     constexpr int W = Chunk::WIDTH;
     constexpr int H = Chunk::HEIGHT;
     constexpr int D = Chunk::DEPTH;
 
-    thread_local RenderType renderType[W + 2][H + 2][D + 2] = {};
-    thread_local uint8_t    blockTypes[W + 2][H + 2][D + 2] = {};
-
-    const int baseWX = coord.x * W;
-    const int baseWZ = coord.y * D;
-
-    // Fill chunk
+    // Faces come from the section layers; their neighbours and AO reach one
+    // layer further either way
+    const int sectionLo = std::countr_zero(sections) * Chunk::SECTION_HEIGHT;
+    const int sectionHi = std::bit_width(sections) * Chunk::SECTION_HEIGHT - 1;
+    const int fillLo = std::max(sectionLo - 1, 0);
+    const int fillHi = std::min(sectionHi + 1, H - 1);
+
+    // Cells never written below (the layers outside the fill, the corner
+    // columns) must read as air
+    auto& arena = ScratchArena::local();
+    auto* renderType = arena.allocateZeroed<RenderType[H + 2][D + 2]>(W + 2);
+    auto* blockTypes = arena.allocateZeroed<uint8_t[H + 2][D + 2]>(W + 2);
+
+    // Fill chunk, noting the band of section layers that hold anything
+    uint8_t maxType = 0;
+    int yMin = H;
+    int yMax = -1;
     for (int x = 0; x < W; ++x)
-        for (int y = 0; y < H; ++y)
+        for (int y = fillLo; y <= fillHi; ++y)
             for (int z = 0; z < D; ++z)
             {
-                const Voxel v = chunk.getVoxel(x, y, z);
+                const Voxel v = voxels[x + y * W + z * W * H];
                 uint8_t bt = getBlockType(v);
+                if (bt && y >= sectionLo && y <= sectionHi) {
+                    maxType = std::max(maxType, bt);
+                    yMin = std::min(yMin, y);
+                    yMax = std::max(yMax, y);
+                }
 
                 renderType[x+1][y+1][z+1] = bt ? blockRenderType(static_cast<BlockType>(bt)) : RenderType::Air;
                 blockTypes[x+1][y+1][z+1] = bt;
             }
 
-    auto sampleBT = [&](const std::vector<Voxel>& voxels, const glm::ivec3& WorldPos) -> uint8_t {
-        const auto localPos = BlockSystem::getLocalCoords(WorldPos);
-
-        Voxel v;
-        if (!voxels.empty())
-            v = voxels[localPos.x + localPos.y * Chunk::WIDTH + localPos.z * Chunk::WIDTH * Chunk::HEIGHT];
-        else
-            v = TerrainGenerator::sampleVoxel(WorldPos.x, WorldPos.y, WorldPos.z);
-
-        return getBlockType(v);
+    // Only band layers, and one either side for AO, are read from the border columns
+    const int borderMin = std::max(yMin - 1, fillLo);
+    const int borderMax = std::min(yMax + 1, fillHi);
+
+    // Meshing waits for all four neighbours, so a missing one means it was
+    // unloaded mid-job and its border stays air. The facing edge slice of
+    // each goes straight into the padding, a few layers of 16 cells each
+    auto padBorder = [&](const ChunkCoord& neighbour, const Chunk::Face face, const int x, const int z) {
+        const EdgeSlice* slice = edgeSlice(neighbour, face);
+        if (!slice)
+            return;
+
+        for (int y = borderMin; y <= borderMax; ++y)
+            for (int c = 0; c < EdgeSlice::CELLS; ++c) {
+                const int px = x < 0 ? c + 1 : x;
+                const int pz = z < 0 ? c + 1 : z;
+                blockTypes[px][y+1][pz] = slice->types[y * EdgeSlice::CELLS + c];
+                renderType[px][y+1][pz] = slice->render[y * EdgeSlice::CELLS + c];
+            }
     };
 
-
-    std::vector<Voxel> leftVoxels;
-    std::vector<Voxel> rightVoxels;
-    std::vector<Voxel> backVoxels;
-    std::vector<Voxel> frontVoxels;
-
-    {
+    if (borderMin <= borderMax) {
         std::lock_guard lock(chunk_mutex);
-
-        if (const auto leftChunk = chunks.find({coord.x - 1, coord.y}); leftChunk != chunks.end()) {
-            leftVoxels.resize(Chunk::SIZE);
-            std::ranges::copy(leftChunk->second.getVoxels(),leftVoxels.begin());
-        }
-
-        if (const auto rightChunk = chunks.find({coord.x + 1, coord.y}); rightChunk != chunks.end()) {
-            rightVoxels.resize(Chunk::SIZE);
-            std::ranges::copy(rightChunk->second.getVoxels(),rightVoxels.begin());
-        }
-
-        if (const auto backChunk = chunks.find({coord.x, coord.y - 1}); backChunk != chunks.end()) {
-            backVoxels.resize(Chunk::SIZE);
-            std::ranges::copy(backChunk->second.getVoxels(),backVoxels.begin());
-        }
-        if (const auto frontChunk = chunks.find({coord.x, coord.y + 1}); frontChunk != chunks.end()) {
-            frontVoxels.resize(Chunk::SIZE);
-            std::ranges::copy(frontChunk->second.getVoxels(),frontVoxels.begin());
-        }
+        padBorder({coord.x - 1, coord.y}, Chunk::POS_X, 0, -1);
+        padBorder({coord.x + 1, coord.y}, Chunk::NEG_X, W + 1, -1);
+        padBorder({coord.x, coord.y - 1}, Chunk::POS_Z, -1, 0);
+        padBorder({coord.x, coord.y + 1}, Chunk::NEG_Z, -1, D + 1);
     }
 
-    for (int y = 0; y < H; ++y)
-        for (int z = 0; z < D; ++z)
-        {
-            auto bt = sampleBT(leftVoxels, {baseWX-1, y, baseWZ+z});
-            blockTypes[0][y+1][z+1]     = bt;
-            renderType[0][y+1][z+1]     = bt ? blockRenderType(static_cast<BlockType>(bt)) : RenderType::Air;
-
-            bt = sampleBT(rightVoxels, {baseWX+W, y, baseWZ+z});
-            blockTypes[W+1][y+1][z+1]   = bt;
-            renderType[W+1][y+1][z+1]   = bt ? blockRenderType(static_cast<BlockType>(bt)) : RenderType::Air;
+    // An all-air chunk has no band and no faces; the binary mesher keeps one
+    // mask set per known block type
+    if (yMin <= yMax) {
+        if (kind == Mesher::Binary && maxType < MESHER_BLOCK_TYPES) {
+            runBinaryPasses(renderType, blockTypes, opaque, transparent, yMin, yMax, maxType + 1);
         }
-
-    for (int x = 0; x < W; ++x)
-        for (int y = 0; y < H; ++y)
-        {
-            auto bt = sampleBT(backVoxels, {baseWX+x, y, baseWZ-1});
-            blockTypes[x+1][y+1][0]     = bt;
-            renderType[x+1][y+1][0]     = bt ? blockRenderType(static_cast<BlockType>(bt)) : RenderType::Air;
-
-            bt = sampleBT(frontVoxels, {baseWX+x, y, baseWZ+D});
-            blockTypes[x+1][y+1][D+1]   = bt;
-            renderType[x+1][y+1][D+1]   = bt ? blockRenderType(static_cast<BlockType>(bt)) : RenderType::Air;
+        else {
+            runGreedyPass(renderType, blockTypes, opaque, transparent, yMin, yMax);
         }
+    }
 
-    chunk.cachedOpaqueVertices.clear();
-    chunk.cachedOpaqueIndices.clear();
-    chunk.cachedTransparentVertices.clear();
-    chunk.cachedTransparentIndices.clear();
-
-    runGreedyPass(RenderType::Opaque,
-        renderType, blockTypes,
-        {chunk.cachedOpaqueVertices, chunk.cachedOpaqueIndices});
-
-    runGreedyPass(RenderType::Transparent,
-        renderType, blockTypes,
-        {chunk.cachedTransparentVertices, chunk.cachedTransparentIndices});
-
-    const glm::vec3 offset(coord.x * W, 0.0f, coord.y * D);
-
-    for (auto& v : chunk.cachedOpaqueVertices) v.position += offset;
-    for (auto& v : chunk.cachedTransparentVertices) v.position += offset;
-
-    chunk.isMeshDirty = false;
-    chunk.aoCalculated = false;
+    groupBySection(opaque);
+    groupBySection(transparent);
 }
 
 // void World::generateChunkGreedyMesh(Chunk& chunk, const ChunkCoord& coord)
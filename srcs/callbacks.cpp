@@ -70,6 +70,42 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
     {
         app->toggleSpeedBoost();
     }
+    else if (key == VOX_KEY_P && action == VOX_PRESS)
+    {
+        app->togglePrediction();
+    }
+    else if (key == VOX_KEY_F && action == VOX_PRESS)
+    {
+        app->startFlythrough();
+    }
+    else if (key == VOX_KEY_B && action == VOX_PRESS)
+    {
+        app->benchmarkVoxelQueries();
+    }
+    else if (key == VOX_KEY_T && action == VOX_PRESS)
+    {
+        app->benchmarkThreadPool();
+    }
+    else if (key == VOX_KEY_C && action == VOX_PRESS)
+    {
+        app->toggleParallelCulling();
+    }
+    else if (key == VOX_KEY_M && action == VOX_PRESS)
+    {
+        app->toggleMesher();
+    }
+    else if (key == VOX_KEY_Q && action == VOX_PRESS)
+    {
+        app->toggleQuadPulling();
+    }
+    else if (key == VOX_KEY_G && action == VOX_PRESS)
+    {
+        app->benchmarkMeshers();
+    }
+    else if (key == VOX_KEY_L && action == VOX_PRESS)
+    {
+        app->toggleLanePolicy();
+    }
     else if (key == VOX_KEY_X && action == VOX_PRESS)
     {
         app->showWireframe = !app->showWireframe;
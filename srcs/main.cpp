@@ -22,6 +22,7 @@
 /*                                                                            */
 /* ************************************************************************** */
 
+#include <chrono>
 #include <cstdlib>
 #include <memory>
 
@@ -30,12 +31,14 @@
 
 int main()
 {
+	const auto processStart = std::chrono::steady_clock::now();
 	std::map<settings_t, bool> settings = {{VOX_FULLSCREEN, false}, {VOX_RESIZE, true}, {VOX_DECORATED, true}, {VOX_MAXIMIZED, false}};
 
 	const auto app = std::make_unique<App>(1440, 720, "PotatoCraft", settings);
 	if (!app.get())
 		return (EXIT_FAILURE);
-	
+
+	app->startup.processStart = processStart;
 	app->run();
 
 	return (EXIT_SUCCESS);
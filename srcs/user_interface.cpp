@@ -13,6 +13,7 @@
 #include "Renderer.hpp"
 #include "Camera.hpp"
 #include "Engine.hpp"
+#include "App.hpp"
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui.h>
@@ -31,7 +32,60 @@ void setupImGui(GLFWwindow* window)
     ImGui::StyleColorsDark();
 }
 
-void renderImGui(const std::unique_ptr<Camera>& camera, bool showWireframe, float rgba[4], const size_t chunkCount)
+static void renderThreadPoolImGui(const DebugStats& debug)
+{
+    const auto& tasks = debug.tasks;
+    const auto& telemetry = debug.telemetry;
+    const auto& scratch = debug.scratch;
+    ImGui::SetNextWindowSize(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::Begin("Thread Pool");
+    ImGui::Text("Lanes (L): %s, queued %zu (interactive %zu, streaming %zu, background %zu)",
+        debug.lanePolicy == ThreadPool::LanePolicy::Strict ? "strict" : "weighted", telemetry.queued,
+        telemetry.laneDepth[0], telemetry.laneDepth[1], telemetry.laneDepth[2]);
+    ImGui::Text("Tasks: %zu submitted, %zu enqueued, %zu slots, %zu heap allocations",
+        tasks.submitted, tasks.enqueued, tasks.slots, tasks.heapAllocations());
+    ImGui::Text("Scratch: %zu arenas, %.1f MiB reserved, peak job %.0f KiB, %llu jobs, %llu heap overflows",
+        scratch.arenas, static_cast<double>(scratch.reservedBytes) / (1 << 20), static_cast<double>(scratch.peakBytes) / 1024.0,
+        static_cast<unsigned long long>(scratch.jobs), static_cast<unsigned long long>(scratch.overflows));
+
+    for (size_t i = 0; i < telemetry.workers.size(); ++i) {
+        const auto& w = telemetry.workers[i];
+        const double total = w.busyMs + w.idleMs;
+        ImGui::Text("Worker %zu: %llu tasks, %llu steals, %.0f%% busy", i,
+            static_cast<unsigned long long>(w.tasks), static_cast<unsigned long long>(w.steals),
+            total > 0.0 ? w.busyMs / total * 100.0 : 0.0);
+    }
+
+    // Enqueue-to-start wait per job kind
+    for (size_t t = 0; t < ThreadPool::TAG_COUNT; ++t) {
+        const auto& histogram = telemetry.wait[t];
+        float counts[ThreadPool::WAIT_BUCKETS];
+        uint64_t total = 0;
+        for (size_t b = 0; b < ThreadPool::WAIT_BUCKETS; ++b) {
+            counts[b] = static_cast<float>(histogram[b]);
+            total += histogram[b];
+        }
+        if (total == 0)
+            continue;
+
+        ImGui::Text("%s wait: %llu tasks, p50 < %.0f us, p99 < %.0f us", ThreadPool::TAG_NAMES[t],
+            static_cast<unsigned long long>(total),
+            ThreadPool::Telemetry::waitPercentileUs(histogram, 0.5),
+            ThreadPool::Telemetry::waitPercentileUs(histogram, 0.99));
+        ImGui::PushID(static_cast<int>(t));
+        ImGui::PlotHistogram("##wait", counts, ThreadPool::WAIT_BUCKETS, 0, "<8 us .. >131 ms, doubling",
+            0.0f, 3.4e38f, ImVec2(0, 40));
+        ImGui::PopID();
+    }
+
+    for (int m = 0; m < 2; ++m)
+        ImGui::Text("%s 1/2/4/8 threads: %.2f %.2f %.2f %.2f M tasks/s", m ? "Stealing (T)" : "Shared   (T)",
+            debug.pool.tasksPerSecond[m][0] / 1e6f, debug.pool.tasksPerSecond[m][1] / 1e6f,
+            debug.pool.tasksPerSecond[m][2] / 1e6f, debug.pool.tasksPerSecond[m][3] / 1e6f);
+    ImGui::End();
+}
+
+void renderImGui(const std::unique_ptr<Camera>& camera, bool showWireframe, float rgba[4], const DebugStats& debug)
 {
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -53,11 +107,79 @@ void renderImGui(const std::unique_ptr<Camera>& camera, bool showWireframe, floa
     drawList->AddLine(ImVec2(center.x - crosshairSize, center.y), ImVec2(center.x + crosshairSize, center.y), whiteColor, 2.0f);
     drawList->AddLine(ImVec2(center.x, center.y - crosshairSize), ImVec2(center.x, center.y + crosshairSize), whiteColor, 2.0f);
 
-    ImGui::Text("Chunk count: %zu", chunkCount);
+    const auto& startup = debug.startup;
+    const auto& viewDistance = debug.viewDistance;
+    const auto& streaming = debug.streaming;
+    const auto& flythrough = debug.flythrough;
+    const auto& queries = debug.queries;
+    const auto& edits = debug.edits;
+    const auto& culling = debug.culling;
+    const auto& meshers = debug.meshers;
+    const auto& uploads = debug.uploads;
+    ImGui::Text("Startup: %.2f s warm-up, %.2f s to first playable frame, %.2f s to fully populated",
+        startup.warmUpSeconds, startup.firstPlayableSeconds, startup.fullyPopulatedSeconds);
+    ImGui::Text("Chunk count: %zu", debug.chunkCount);
+    ImGui::Text("View radius: %d chunks (%.1f ms avg CPU frame)", viewDistance.radius(), viewDistance.averageFrameMs());
+    ImGui::Text("  %s", viewDistance.reason().c_str());
+    ImGui::Text("Pending loads: %zu, %zu meshable awaiting view", streaming.pendingLoads, streaming.awaitingView);
+    ImGui::Text("Chunk memory: %.0f / %.0f MiB, %llu evicted",
+        static_cast<float>(streaming.residentBytes) / (1 << 20), static_cast<float>(streaming.memoryBudget) / (1 << 20),
+        static_cast<unsigned long long>(streaming.evictedChunks));
+    ImGui::Text("Time to visible: %.0f ms avg, %.0f ms last",
+        streaming.avgTimeToVisible * 1000.0f, streaming.lastTimeToVisible * 1000.0f);
+    ImGui::Text("Generations: %llu useful, %llu wasted, %llu cancelled",
+        static_cast<unsigned long long>(streaming.usefulGenerations),
+        static_cast<unsigned long long>(streaming.wastedGenerations),
+        static_cast<unsigned long long>(streaming.cancelledLoads));
+    ImGui::Text("Prediction (P): %s, %.0f blocks/s, %zu prefetched",
+        debug.prediction ? "on" : "off", streaming.speed, streaming.prefetchedChunks);
+    if (flythrough.active)
+        ImGui::Text("Flythrough run %d: %s %.1f s", flythrough.run + 1,
+            flythrough.settling ? "settling" : "flying", flythrough.elapsed);
+    else
+        ImGui::Text("Flythrough (F): %.1f holes/s without prediction, %.1f with",
+            flythrough.holesPerSecond[0], flythrough.holesPerSecond[1]);
+    ImGui::Text("Voxel queries (B): %.1f M/s lookup, %.1f M/s neighborhood%s",
+        queries.beforeQps / 1e6f, queries.afterQps / 1e6f, queries.mismatch ? " (MISMATCH)" : "");
+    ImGui::Text("Edit latency: %zu edits, last %.0f ms, max %.0f ms", edits.samples, edits.lastMs, edits.maxMs);
+    ImGui::PlotHistogram("##edits", edits.counts, EditLatency::BUCKETS, 0, "<8 ms .. >2 s, doubling", 0.0f, 3.4e38f, ImVec2(0, 60));
+    ImGui::Text("Culling (C): %s, %zu chunks, %.2f ms serial, %.2f ms parallel",
+        culling.parallel ? "parallel" : "serial", culling.chunks, culling.avgMs[0], culling.avgMs[1]);
+    ImGui::Text("Mesher (M): %s; benchmark (G) over %zu loaded chunks, %zu differ",
+        debug.mesher == Mesher::Binary ? "binary" : "scalar", meshers.chunks, meshers.mismatches);
+    for (int set = 0; set < MesherBenchmark::SET_COUNT; ++set)
+        ImGui::Text("  %-8s %6.0f scalar, %6.0f binary chunks/s", MesherBenchmark::SET_NAMES[set],
+            meshers.chunksPerSecond[set][0], meshers.chunksPerSecond[set][1]);
+    ImGui::Text("Chunk rendering (Q): %s", debug.quadPulling ? "quad pulling, 8 B per quad" : "vertices, 32 B per quad");
+    ImGui::Text("Mesh uploads: %zu this frame (%zu sections), %.1f KiB, %zu queued",
+        uploads.uploadsThisFrame, uploads.sectionsThisFrame, static_cast<float>(uploads.bytesThisFrame) / 1024.0f,
+        uploads.queueDepth);
     ImGui::Checkbox("Wireframe", &showWireframe);
     ImGui::ColorEdit4("Color", rgba);
     ImGui::End();
 
+    renderThreadPoolImGui(debug);
+
+    ImGui::Render();
+    glViewport(0, 0, ImGui::GetIO().DisplaySize.x, ImGui::GetIO().DisplaySize.y);
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
+void renderWarmUpImGui(const size_t done, const size_t total, const float elapsed)
+{
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplGlfw_NewFrame();
+    ImGui::NewFrame();
+
+    const ImVec2 center = ImGui::GetIO().DisplaySize * 0.5f;
+    ImGui::SetNextWindowPos(center, ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(360, 0), ImGuiCond_Always);
+    ImGui::Begin("Loading", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove);
+    ImGui::Text("Generating spawn area... %.1f s", elapsed);
+    ImGui::ProgressBar(total ? static_cast<float>(done) / static_cast<float>(total) : 1.0f, ImVec2(-1, 0));
+    ImGui::Text("%zu / %zu chunks", done, total);
+    ImGui::End();
+
     ImGui::Render();
     glViewport(0, 0, ImGui::GetIO().DisplaySize.x, ImGui::GetIO().DisplaySize.y);
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());